@@ -16,6 +16,7 @@ plugin(plugin), menu_handler(menu_handler)
 
   int param_global = 0;
   int module_global = 0;
+  int modulatable_global = 0;
   int midi_source_global = 0;
   int output_source_global = 0;
 
@@ -25,6 +26,7 @@ plugin(plugin), menu_handler(menu_handler)
     midi_mappings.topo_to_index.emplace_back();
     param_mappings.topo_to_index.emplace_back();
     output_mappings.topo_to_index.emplace_back();
+    param_mappings.topo_to_modulatable.emplace_back();
     if(module.dsp.stage == module_stage::input) module_voice_start++;
     if(module.dsp.stage == module_stage::input) module_output_start++;
     if(module.dsp.stage == module_stage::voice) module_output_start++;
@@ -37,6 +39,7 @@ plugin(plugin), menu_handler(menu_handler)
       midi_mappings.topo_to_index[m].emplace_back();
       param_mappings.topo_to_index[m].emplace_back();
       output_mappings.topo_to_index[m].emplace_back();
+      param_mappings.topo_to_modulatable[m].emplace_back();
       modules.emplace_back(module_desc(module, m, mi, module_global++, param_global, midi_source_global, output_source_global));
       for (int ms = 0; ms < module.midi_sources.size(); ms++)
       {
@@ -52,6 +55,9 @@ plugin(plugin), menu_handler(menu_handler)
         param_mappings.topo_to_index[m][mi].emplace_back();
         for(int pi = 0; pi < param.info.slot_count; pi++)
           param_mappings.topo_to_index[m][mi][p].push_back(param_global++);
+        bool can_modulate = param.dsp.can_modulate(mi);
+        param_mappings.topo_to_modulatable[m][mi].push_back(can_modulate? modulatable_global: -1);
+        if(can_modulate) modulatable_global += param.info.slot_count;
       }
     }
   }
@@ -137,6 +143,7 @@ plugin(plugin), menu_handler(menu_handler)
   }
 
   param_count = param_global;
+  modulatable_count = modulatable_global;
   midi_count = midi_source_global;
   output_count = output_source_global;
   module_count = modules.size();
@@ -258,14 +265,18 @@ void
 plugin_param_mappings::validate(plugin_desc const& plugin) const
 {
   assert(params.size() == plugin.param_count);
+  assert(plugin.modulatable_count <= plugin.param_count);
   assert(tag_to_index.size() == plugin.param_count);
   assert(index_to_tag.size() == plugin.param_count);
   assert(id_to_index.size() == plugin.plugin->modules.size());
   assert(id_to_index.size() == plugin.plugin->modules.size());
   assert(topo_to_index.size() == plugin.plugin->modules.size());
+  assert(topo_to_modulatable.size() == plugin.plugin->modules.size());
 
   int param_global = 0;
+  int modulatable_global = 0;
   (void)param_global;
+  (void)modulatable_global;
   for (int m = 0; m < plugin.plugin->modules.size(); m++)
   {
     auto const& module = plugin.plugin->modules[m];
@@ -275,15 +286,24 @@ plugin_param_mappings::validate(plugin_desc const& plugin) const
     for (int mi = 0; mi < module.info.slot_count; mi++)
     {
       assert(topo_to_index[m][mi].size() == module.params.size());
+      assert(topo_to_modulatable[m][mi].size() == module.params.size());
       for (int p = 0; p < module.params.size(); p++)
       {
         auto const& param = module.params[p];
         assert(topo_to_index[m][mi][p].size() == param.info.slot_count);
         for (int pi = 0; pi < param.info.slot_count; pi++)
           assert(topo_to_index[m][mi][p][pi] == param_global++);
+        if (!param.dsp.can_modulate(mi))
+          assert(topo_to_modulatable[m][mi][p] == -1);
+        else
+        {
+          assert(topo_to_modulatable[m][mi][p] == modulatable_global);
+          modulatable_global += param.info.slot_count;
+        }
       }
     }
   }
+  assert(modulatable_global == plugin.modulatable_count);
 
   for (int p = 0; p < plugin.params.size(); p++)
   {
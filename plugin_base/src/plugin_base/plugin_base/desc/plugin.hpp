@@ -78,6 +78,8 @@ struct plugin_param_mappings final {
   std::vector<param_mapping> params = {};
   std::map<std::string, std::map<std::string, int>> id_to_index = {};
   std::vector<std::vector<std::vector<std::vector<int>>>> topo_to_index = {};
+  // index into tables over modulatable params only, -1 if not modulatable, param slots follow
+  std::vector<std::vector<std::vector<int>>> topo_to_modulatable = {};
 
   void validate(plugin_desc const& plugin) const;
   PB_PREVENT_ACCIDENTAL_COPY_DEFAULT_CTOR(plugin_param_mappings);
@@ -96,6 +98,7 @@ public:
   int param_count = {};
   int output_count = {};
   int module_count = {};
+  int modulatable_count = {};
   int module_voice_start = {};
   int module_output_start = {};
 
@@ -21,12 +21,49 @@ enum class voice_stage { unused, active, releasing, finishing };
 enum class mono_note_stream_event { none, on, off };
 
 // for monophonic mode
+// the stream holds change points only: sorted by frame, at most 1 per frame
 struct mono_note_state
 {
+  int frame = -1;
   int midi_key = -1;
   mono_note_stream_event event_type = mono_note_stream_event::none;
 };
 
+// for monophonic mode, forward-only walk over the stream
+// frames passed to at() must not decrease between calls
+class mono_note_cursor
+{
+  int _index = 0;
+  std::vector<mono_note_state> const* const _stream;
+
+public:
+  mono_note_cursor(std::vector<mono_note_state> const& stream) : _stream(&stream) {}
+
+  mono_note_state const* at(int frame);
+  int next_on(int after, int end_frame) const;
+};
+
+// event at this frame or null
+inline mono_note_state const* 
+mono_note_cursor::at(int frame)
+{
+  auto const& stream = *_stream;
+  while (_index < stream.size() && stream[_index].frame < frame) _index++;
+  if (_index < stream.size() && stream[_index].frame == frame) return &stream[_index];
+  return nullptr;
+}
+
+// first note-on frame after the given one, or end_frame if none before that
+inline int
+mono_note_cursor::next_on(int after, int end_frame) const
+{
+  auto const& stream = *_stream;
+  for (int i = _index; i < stream.size() && stream[i].frame < end_frame; i++)
+    if (stream[i].frame > after && stream[i].event_type == mono_note_stream_event::on)
+      return stream[i].frame;
+  return end_frame;
+}
+
 // for MTS-ESP tuning
 struct note_tuning
 {
@@ -0,0 +1,105 @@
+#include <plugin_base/dsp/convolver.hpp>
+
+#include <algorithm>
+
+namespace plugin_base {
+
+partitioned_convolver::
+partitioned_convolver(std::vector<float> const& impulse_response)
+{
+  int length = (int)impulse_response.size();
+  _head = std::vector<float>(head_size, 0.0f);
+  _head_history = std::vector<float>(head_size * 2, 0.0f);
+  std::copy(impulse_response.begin(), impulse_response.begin() + std::min(length, head_size), _head.begin());
+
+  for (int i = 0; i < stage_count; i++)
+  {
+    stage& s = _stages[i];
+    s.size = stage_sizes[i];
+    int start = s.size;
+    int end = i == stage_count - 1 ? length : std::min(length, stage_sizes[i + 1]);
+    if (end <= start) continue;
+
+    int bins = (s.size + 1) * 2;
+    s.partitions = (end - start + s.size - 1) / s.size;
+    s.fft = std::make_unique<cached_fft>(s.size * 2);
+    s.fft_buffer = std::vector<float>(s.size * 4, 0.0f);
+    s.input = std::vector<float>(s.size * 2, 0.0f);
+    s.output = std::vector<float>(s.size, 0.0f);
+    s.accumulator = std::vector<float>(bins, 0.0f);
+    s.fdl = std::vector<float>(s.partitions * bins, 0.0f);
+    s.spectra = std::vector<float>(s.partitions * bins, 0.0f);
+
+    for (int p = 0; p < s.partitions; p++)
+    {
+      int from = start + p * s.size;
+      int to = std::min(end, from + s.size);
+      std::fill(s.fft_buffer.begin(), s.fft_buffer.end(), 0.0f);
+      std::copy(impulse_response.begin() + from, impulse_response.begin() + to, s.fft_buffer.begin());
+      s.fft->forward(s.fft_buffer.data());
+      std::copy(s.fft_buffer.begin(), s.fft_buffer.begin() + bins, s.spectra.begin() + p * bins);
+    }
+  }
+}
+
+void
+partitioned_convolver::clear()
+{
+  _head_pos = 0;
+  std::fill(_head_history.begin(), _head_history.end(), 0.0f);
+  for (int i = 0; i < stage_count; i++)
+  {
+    _stages[i].pos = 0;
+    _stages[i].fdl_pos = 0;
+    std::fill(_stages[i].fdl.begin(), _stages[i].fdl.end(), 0.0f);
+    std::fill(_stages[i].input.begin(), _stages[i].input.end(), 0.0f);
+    std::fill(_stages[i].output.begin(), _stages[i].output.end(), 0.0f);
+    std::fill(_stages[i].accumulator.begin(), _stages[i].accumulator.end(), 0.0f);
+  }
+}
+
+// partition p multiplies against the block p blocks back, fdl_pos is where the 
+// running block goes, so the older ones are all there before it completes
+void
+partitioned_convolver::accumulate(stage& s, int from, int to)
+{
+  int bins = (s.size + 1) * 2;
+  float* acc = s.accumulator.data();
+  for (int p = from; p < to; p++)
+  {
+    int slot = (s.fdl_pos + s.partitions - p) % s.partitions;
+    float const* x = s.fdl.data() + slot * bins;
+    float const* h = s.spectra.data() + p * bins;
+    for (int b = 0; b < bins; b += 2)
+    {
+      acc[b] += x[b] * h[b] - x[b + 1] * h[b + 1];
+      acc[b + 1] += x[b] * h[b + 1] + x[b + 1] * h[b];
+    }
+  }
+}
+
+// input holds the previous and current block, transform that into the
+// frequency domain delay line, add partition 0 to what was accumulated during
+// the block and the second half of the inverse transform is the output for the next block
+void
+partitioned_convolver::process_stage(stage& s)
+{
+  int bins = (s.size + 1) * 2;
+  float* buffer = s.fft_buffer.data();
+  std::copy(s.input.begin(), s.input.end(), buffer);
+  std::fill(buffer + s.size * 2, buffer + s.size * 4, 0.0f);
+  s.fft->forward(buffer);
+  std::copy(buffer, buffer + bins, s.fdl.begin() + s.fdl_pos * bins);
+  accumulate(s, 0, 1);
+  s.fdl_pos = (s.fdl_pos + 1) % s.partitions;
+
+  float* acc = s.accumulator.data();
+  std::copy(acc, acc + bins, buffer);
+  std::fill(acc, acc + bins, 0.0f);
+  std::fill(buffer + bins, buffer + s.size * 4, 0.0f);
+  s.fft->inverse(buffer);
+  std::copy(buffer + s.size, buffer + s.size * 2, s.output.begin());
+  std::copy(s.input.begin() + s.size, s.input.end(), s.input.begin());
+}
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <plugin_base/shared/utility.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace plugin_base {
+
+// zero latency non-uniform partitioned convolution, single channel
+// direct form fir for the head of the impulse response, then uniform
+// partitioned overlap-save stages where each stage covers the part of the
+// impulse response starting at its own block size up to the next stage
+// only partition 0 needs the block that just completed, the older partitions are
+// multiply-added a few at a time while the block is running, so the end of the block
+// only does the ffts and a single partition instead of all of them at once
+// construction does all allocation and fft work, so keep it off the audio thread
+class partitioned_convolver
+{
+  static int constexpr stage_count = 2;
+  static constexpr std::array<int, stage_count> stage_sizes = { 64, 1024 };
+  static int constexpr head_size = stage_sizes[0];
+
+  // fft size is 2 * size, spectra are size + 1 complex bins
+  struct stage
+  {
+    int pos = 0;
+    int size = 0;
+    int fdl_pos = 0;
+    int partitions = 0;
+    std::unique_ptr<cached_fft> fft = {};
+    std::vector<float> fft_buffer = {};
+    std::vector<float> input = {};
+    std::vector<float> output = {};
+    std::vector<float> fdl = {};
+    std::vector<float> spectra = {};
+    std::vector<float> accumulator = {};
+  };
+
+  int _head_pos = 0;
+  std::vector<float> _head = {};
+  std::vector<float> _head_history = {};
+  std::array<stage, stage_count> _stages = {};
+
+  void process_stage(stage& s);
+  void accumulate(stage& s, int from, int to);
+
+public:
+  PB_PREVENT_ACCIDENTAL_COPY(partitioned_convolver);
+  partitioned_convolver(std::vector<float> const& impulse_response);
+
+  void clear();
+  float next(float in);
+};
+
+inline float
+partitioned_convolver::next(float in)
+{
+  // history is written twice so the fir reads one contiguous range
+  _head_history[_head_pos] = in;
+  _head_history[_head_pos + head_size] = in;
+  float const* history = _head_history.data() + _head_pos;
+  float result = 0.0f;
+  for (int i = 0; i < head_size; i++)
+    result += _head[i] * history[i];
+  _head_pos = (_head_pos + head_size - 1) % head_size;
+
+  // stage output was computed at the end of the previous block
+  for (int i = 0; i < stage_count; i++)
+  {
+    stage& s = _stages[i];
+    if (s.partitions == 0) continue;
+    result += s.output[s.pos];
+    s.input[s.size + s.pos] = in;
+
+    // spread partitions 1 until partitions over the block
+    int from = 1 + (s.partitions - 1) * s.pos / s.size;
+    int to = 1 + (s.partitions - 1) * (s.pos + 1) / s.size;
+    if (from < to) accumulate(s, from, to);
+    if (++s.pos == s.size)
+    {
+      process_stage(s);
+      s.pos = 0;
+    }
+  }
+  return result;
+}
+
+}
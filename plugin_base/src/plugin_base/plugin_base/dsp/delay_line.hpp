@@ -0,0 +1,99 @@
+#pragma once
+
+#include <plugin_base/shared/utility.hpp>
+
+#include <vector>
+#include <cassert>
+#include <algorithm>
+
+namespace plugin_base {
+
+// single channel circular buffer for comb, delay and reverb lines
+// capacity is a power of 2 so wrapping is a bitmask instead of a modulo
+// usage per sample is read() then write(), so delay 1 is the last written sample
+// clear() is constant time: it only forgets how much was written, reads 
+// further back than that return 0, so resetting voices and patches does 
+// not zero out (up to) seconds of audio on the audio thread
+class delay_line
+{
+  int _pos = 0;
+  int _mask = 0;
+  int _fill = 0;
+  std::vector<float> _buffer = {};
+
+public:
+  void clear();
+  void init(int max_delay);
+  int capacity() const { return _mask + 1; }
+
+  void write(float val);
+  float read(int delay) const;
+
+  // fractional delay, integer part is the same as read()
+  float read_linear(float delay) const;
+
+  // block versions of read/write, read_block needs delay >= count
+  void write_block(float const* in, int count);
+  void read_block(int delay, float* out, int count) const;
+};
+
+inline void
+delay_line::clear()
+{ _fill = 0; }
+
+// some headroom for the interpolation taps
+inline void
+delay_line::init(int max_delay)
+{
+  assert(max_delay >= 0);
+  int capacity = (int)next_pow2(max_delay + 4);
+  _pos = 0;
+  _fill = 0;
+  _mask = capacity - 1;
+  _buffer = std::vector<float>(capacity, 0.0f);
+}
+
+inline void
+delay_line::write(float val)
+{
+  _buffer[_pos] = val;
+  _pos = (_pos + 1) & _mask;
+  _fill += _fill <= _mask;
+}
+
+// delay 0 is the oldest slot, only valid when full
+inline float
+delay_line::read(int delay) const
+{ return ((delay - 1) & _mask) < _fill ? _buffer[(_pos - delay) & _mask] : 0.0f; }
+
+inline float
+delay_line::read_linear(float delay) const
+{
+  int i = (int)delay;
+  float t = delay - i;
+  return (1 - t) * read(i) + t * read(i + 1);
+}
+
+inline void
+delay_line::write_block(float const* in, int count)
+{
+  assert(count <= capacity());
+  int first = std::min(count, capacity() - _pos);
+  std::copy(in, in + first, _buffer.data() + _pos);
+  std::copy(in + first, in + count, _buffer.data());
+  _pos = (_pos + count) & _mask;
+  _fill = std::min(capacity(), _fill + count);
+}
+
+inline void
+delay_line::read_block(int delay, float* out, int count) const
+{
+  assert(count <= delay && delay <= capacity());
+  int start = (_pos - delay) & _mask;
+  int first = std::min(count, capacity() - start);
+  std::copy(_buffer.data() + start, _buffer.data() + start + first, out);
+  std::copy(_buffer.data(), _buffer.data() + count - first, out + first);
+  if (delay - _fill > 0) std::fill(out, out + std::min(count, delay - _fill), 0.0f);
+}
+
+}
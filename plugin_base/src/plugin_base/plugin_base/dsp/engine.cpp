@@ -28,8 +28,6 @@ plugin_engine(
 _graph(graph),
 _polyphony(topo_polyphony(desc, graph)),
 _state(desc, false), 
-_block_automation(desc, false),
-_voice_automation(_polyphony, plugin_state(desc, false)),
 _dims(*desc->plugin, _polyphony),
 _host_block(std::make_unique<host_block>()),
 _voice_processor(voice_processor),
@@ -49,6 +47,17 @@ _voice_processor_context(voice_processor_context)
   _global_context.resize(_dims.module_slot);
   _voice_context.resize(_dims.voice_module_slot);
   _output_values.resize(_dims.module_slot_param_slot);
+
+  // block and voice automation start out at the default state
+  _block_automation.resize(_dims.module_slot_param_slot);
+  for (int i = 0; i < desc->param_count; i++)
+  {
+    auto const& topo = desc->param_mappings.params[i].topo;
+    _block_automation[topo.module_index][topo.module_slot][topo.param_index][topo.param_slot] = _state.get_plain_at_index(i);
+  }
+  for (int v = 0; v < _polyphony; v++)
+    _voice_automation.emplace_back(_block_automation);
+
   _input_engines.resize(_dims.module_slot);
   _output_engines.resize(_dims.module_slot);
   _voice_engines.resize(_dims.voice_module_slot);
@@ -137,11 +146,11 @@ plugin_engine::make_plugin_block(
 
   // fix param_rate::voice values to voice start
   jarray<plain_value, 2> const& own_block_auto = voice < 0
-    ? _block_automation.state()[module][slot]
-    : _voice_automation[voice].state()[module][slot];
+    ? _block_automation[module][slot]
+    : _voice_automation[voice][module][slot];
   jarray<plain_value, 4> const& all_block_auto = voice < 0
-    ? _block_automation.state()
-    : _voice_automation[voice].state();
+    ? _block_automation
+    : _voice_automation[voice];
 
   std::vector<modulation_output>* modulation_outputs = voice < 0
     ? &_global_modulation_outputs
@@ -197,7 +206,7 @@ plugin_engine::make_plugin_block(
 void
 plugin_engine::init_from_state(plugin_state const* state)
 {
-  _state.copy_from(state->state(), true);
+  _state.copy_from(*state, true);
   automation_state_dirty();
   init_automation_from_state();
 }        
@@ -331,7 +340,7 @@ plugin_engine::activate(int max_frame_count)
   _midi_automation.resize(frame_dims.midi_automation);
   _accurate_automation.resize(frame_dims.accurate_automation);
   _bpm_automation.resize(max_frame_count);
-  _mono_note_stream.resize(max_frame_count);
+  _mono_note_stream.reserve(max_frame_count);
   _host_block->events.activate(_graph, 
     _state.desc().module_count, _state.desc().param_count, 
     _state.desc().midi_count, _polyphony, max_frame_count);
@@ -441,7 +450,7 @@ plugin_engine::voice_block_params_snapshot(int v)
         if (module.params[p].dsp.rate != param_rate::accurate)
           for (int mi = 0; mi < module.info.slot_count; mi++)
             for (int pi = 0; pi < module.params[p].info.slot_count; pi++)
-              _voice_automation[v].set_plain_at(m, mi, p, pi, _block_automation.get_plain_at(m, mi, p, pi));
+              _voice_automation[v][m][mi][p][pi] = _block_automation[m][mi][p][pi];
   }
 }
 
@@ -463,7 +472,7 @@ plugin_engine::init_automation_from_state()
             if(_param_was_automated[m][mi][p][pi] != 0)
             {
               _param_was_automated[m][mi][p][pi] = 0;
-              _block_automation.set_plain_at(m, mi, p, pi, _state.get_plain_at(m, mi, p, pi));
+              _block_automation[m][mi][p][pi] = _state.get_plain_at(m, mi, p, pi);
             }
         }
         else
@@ -691,7 +700,8 @@ plugin_engine::process()
     // we update state right here so no need to mark as automated
     auto const& event = _host_block->events.block[e];
     _state.set_normalized_at_index(event.param, event.normalized);
-    _block_automation.set_normalized_at_index(event.param, event.normalized);
+    auto const& topo = _state.desc().param_mappings.params[event.param].topo;
+    _block_automation[topo.module_index][topo.module_slot][topo.param_index][topo.param_slot] = _state.get_plain_at_index(event.param);
   }
 
   // microtuning mode
@@ -1024,8 +1034,16 @@ plugin_engine::process()
     voice_mode = _state.get_plain_at(topo.engine.voice_mode.module_index, 0, topo.engine.voice_mode.param_index, 0).step();
     assert(voice_mode == engine_voice_mode_mono || voice_mode == engine_voice_mode_poly || voice_mode == engine_voice_mode_release);
 
-    // for mono mode
-    std::fill(_mono_note_stream.begin(), _mono_note_stream.end(), mono_note_state { _last_note_key, mono_note_stream_event::none });
+    // for mono mode, at most 1 change point per frame so never reallocates
+    _mono_note_stream.clear();
+    // last event on the same frame wins
+    auto push_mono_note = [this](note_event const& event, mono_note_stream_event type) {
+      mono_note_state state = { event.frame, event.id.key, type };
+      if (_mono_note_stream.size() && _mono_note_stream.back().frame == event.frame)
+        _mono_note_stream.back() = state;
+      else
+        _mono_note_stream.push_back(state);
+    };
 
     if(voice_mode == engine_voice_mode_poly)
     {
@@ -1065,26 +1083,27 @@ plugin_engine::process()
 
       // set up note-off stream, plugin will have to do something with it
       // so first check if there's a "real" note-off in there (not caused by an note-on at the same sample pos)
+      // notes are ordered by frame, so look at all events on the same frame in one go
       int first_note_off_index = -1;
-      for (int e = 0; e < _arp_notes.size(); e++)
-        if (_arp_notes[e].type == note_event_type::off)
-        {
-          // if a note off is caused by another note on at the same sample position, ignore it
-          auto const& event = _arp_notes[e];
-          bool note_on_found_this_pos = false;
-          for (int e2 = 0; e2 < _arp_notes.size(); e2++)
-            if (_arp_notes[e2].type == note_event_type::on && _arp_notes[e2].frame == event.frame)
+      for (int e = 0; e < _arp_notes.size();)
+      {
+        int frame = _arp_notes[e].frame;
+        int frame_end = e;
+        bool note_on_found_this_pos = false;
+        for (; frame_end < _arp_notes.size() && _arp_notes[frame_end].frame == frame; frame_end++)
+          note_on_found_this_pos |= _arp_notes[frame_end].type == note_event_type::on;
+        assert(frame_end == _arp_notes.size() || _arp_notes[frame_end].frame > frame);
+
+        // if a note off is caused by another note on at the same sample position, ignore it
+        if (!note_on_found_this_pos)
+          for (; e < frame_end; e++)
+            if (_arp_notes[e].type == note_event_type::off)
             {
-              note_on_found_this_pos = true;
-              break;
+              push_mono_note(_arp_notes[e], mono_note_stream_event::off);
+              first_note_off_index = frame;
             }
-          if (!note_on_found_this_pos)
-          {
-            std::fill(_mono_note_stream.begin() + event.frame, _mono_note_stream.end(), mono_note_state{ event.id.key, mono_note_stream_event::none });
-            _mono_note_stream[event.frame].event_type = mono_note_stream_event::off;
-            first_note_off_index = event.frame;
-          }
-        }
+        e = frame_end;
+      }
 
       // if there's no true note-off in this block, check for note-on
       int first_note_on_index = -1;
@@ -1160,8 +1179,7 @@ plugin_engine::process()
             auto const& event = _arp_notes[e];
             _last_note_key = event.id.key;
             _last_note_channel = event.id.channel;
-            std::fill(_mono_note_stream.begin() + event.frame, _mono_note_stream.end(), mono_note_state { event.id.key, mono_note_stream_event::none });
-            _mono_note_stream[event.frame].event_type = mono_note_stream_event::on;
+            push_mono_note(event, mono_note_stream_event::on);
           }
       }
     }
@@ -77,11 +77,11 @@ class plugin_engine final {
 
   plugin_dims const _dims;
   plugin_state _state = {};
-  plugin_state _block_automation = {};
+  jarray<plain_value, 4> _block_automation = {};
   jarray<void*, 3> _voice_context = {};
   jarray<void*, 2> _global_context = {};
   jarray<plain_value, 4> _output_values = {};
-  jarray<plugin_state, 1> _voice_automation = {};
+  std::vector<jarray<plain_value, 4>> _voice_automation = {};
 
   float _sample_rate = {};
   int _max_frame_count = {};
@@ -162,6 +162,41 @@ dc_filter::next(int ch, float in)
   return out;
 }
 
+// same as dc_filter but for many lanes at once, e.g. osc unison voices
+// lanes are kept in separate arrays so next() vectorizes across them
+// next() can be limited to the first count lanes, e.g. active unison voices
+template <int Lanes>
+class dc_filter_lanes
+{
+  float _r = 0;
+  float _x0[Lanes];
+  float _y0[Lanes];
+public:
+  void next(float* inout, int count = Lanes);
+  void init(float sr, float freq_hz);
+};
+
+template <int Lanes> inline void
+dc_filter_lanes<Lanes>::init(float sr, float freq_hz)
+{
+  _r = 1 - (pi32 * 2 * freq_hz / sr);
+  for (int l = 0; l < Lanes; l++)
+    _x0[l] = _y0[l] = 0;
+}
+
+template <int Lanes> inline void
+dc_filter_lanes<Lanes>::next(float* inout, int count)
+{
+  assert(0 < count && count <= Lanes);
+  for (int l = 0; l < count; l++)
+  {
+    float out = inout[l] - _x0[l] + _y0[l] * _r;
+    _x0[l] = inout[l];
+    _y0[l] = out;
+    inout[l] = out;
+  }
+}
+
 inline std::uint32_t
 fast_rand_seed(int seed)
 { return std::numeric_limits<uint32_t>::max() / seed; }
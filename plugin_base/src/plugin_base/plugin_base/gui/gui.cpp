@@ -239,7 +239,7 @@ gui_undo_listener::mouseUp(MouseEvent const& event)
       if (load_result.ok() && !load_result.warnings.size())
       {
         int undo_token = _gui->automation_state()->begin_undo_region();
-        _gui->automation_state()->copy_from(new_state.state(), true);
+        _gui->automation_state()->copy_from(new_state, true);
         _gui->automation_state()->end_undo_region(undo_token, "Paste", "Patch");
       }
       else
@@ -358,12 +358,12 @@ _undo_listener(this), _extra_state(extra_state), _modulation_outputs(modulation_
   auto const& topo = *automation_state->desc().plugin;
   _engine_voices_active.resize(automation_state->desc().plugin->audio_polyphony);
   _engine_voices_activated.resize(automation_state->desc().plugin->audio_polyphony);
-  _global_modulation_state.copy_from(automation_state->state(), false);
+  _global_modulation_state.copy_from(*automation_state, false);
   _voice_modulation_states.resize(automation_state->desc().plugin->audio_polyphony);
   for (int i = 0; i < automation_state->desc().plugin->audio_polyphony; i++)
   {
     new(&_voice_modulation_states[i]) plugin_state(&automation_state->desc(), false);
-    _voice_modulation_states[i].copy_from(automation_state->state(), false);
+    _voice_modulation_states[i].copy_from(*automation_state, false);
   }
   theme_changed(user_io_load_list(topo.vendor, topo.full_name, user_io::base, user_state_theme_key, topo.gui.default_theme, automation_state->desc().plugin->themes()));
 }
@@ -692,7 +692,7 @@ plugin_gui::modulation_outputs_changed(int force_requery_automation_param)
   double seconds_now = seconds_since_epoch();
   if (seconds_now - _last_mod_reset_seconds >= mod_reset_interval)
   {
-    _global_modulation_state.copy_from(_automation_state->state(), false);
+    _global_modulation_state.copy_from(*_automation_state, false);
     _last_mod_reset_seconds = seconds_now;
     for (auto listener_it : _modulation_output_listeners)
       listener_it->modulation_outputs_reset();
@@ -710,7 +710,7 @@ plugin_gui::modulation_outputs_changed(int force_requery_automation_param)
 
       // revert to automation if needed
       if (!voice_event.is_active)
-        _voice_modulation_states[voice_event.voice_index].copy_from(_automation_state->state(), false);
+        _voice_modulation_states[voice_event.voice_index].copy_from(*_automation_state, false);
 
     } else if ((*_modulation_outputs)[i].event_type() == out_event_param_state)
     {
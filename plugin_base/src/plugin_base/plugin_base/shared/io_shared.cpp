@@ -1,4 +1,5 @@
 #include <plugin_base/shared/io_shared.hpp>
+#include <juce_core/juce_core.h>
 
 namespace plugin_base {
 
@@ -18,4 +19,19 @@ user_location(std::string const& vendor, std::string const& full_name)
   return result.string();
 }
 
+std::filesystem::path
+user_data_location(std::string const& vendor, std::string const& full_name)
+{
+#ifdef __linux__
+  // user_location falls back to a relative .config
+  char const* home = std::getenv("HOME");
+  auto result = std::filesystem::path(user_location(vendor, full_name));
+  if (result.is_relative() && home != nullptr) result = std::filesystem::path(home) / result;
+  return result;
+#else
+  auto user_data = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory);
+  return std::filesystem::path(user_data.getFullPathName().toStdString()) / user_location(vendor, full_name);
+#endif
+}
+
 }
\ No newline at end of file
@@ -2,12 +2,19 @@
 
 #include <plugin_base/topo/plugin.hpp>
 #include <string>
+#include <filesystem>
 
 namespace plugin_base {
 
+inline char constexpr user_folder_impulse_responses[] = "impulse_responses";
+
 std::string
 user_location(plugin_topo const& topo);
 std::string
 user_location(std::string const& vendor, std::string const& full_name);
 
+// full path to per-user files like the log and user-provided impulse responses
+std::filesystem::path
+user_data_location(std::string const& vendor, std::string const& full_name);
+
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include <plugin_base/shared/io_wav.hpp>
+#include <plugin_base/shared/utility.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+namespace plugin_base {
+
+static int const wav_format_pcm = 1;
+static int const wav_format_float = 3;
+static int const wav_format_extensible = 0xFFFE;
+
+static std::uint32_t
+read_le(char const* data, int bytes)
+{
+  std::uint32_t result = 0;
+  for (int i = 0; i < bytes; i++)
+    result |= (std::uint32_t)(std::uint8_t)data[i] << (i * 8);
+  return result;
+}
+
+static float
+read_sample(char const* data, int format, int bits)
+{
+  if (format == wav_format_float && bits == 32)
+  {
+    float result;
+    std::memcpy(&result, data, sizeof(result));
+    return result;
+  }
+  if (format == wav_format_float && bits == 64)
+  {
+    double result;
+    std::memcpy(&result, data, sizeof(result));
+    return (float)result;
+  }
+  if (bits == 16) return (std::int16_t)read_le(data, 2) / 32768.0f;
+  if (bits == 24) return ((std::int32_t)(read_le(data, 3) << 8) >> 8) / 8388608.0f;
+  return (std::int32_t)read_le(data, 4) / 2147483648.0f;
+}
+
+bool
+wav_load(std::filesystem::path const& path, wav_data& result)
+{
+  result = {};
+  auto data = file_load(path);
+  if (data.size() < 12) return false;
+  if (std::memcmp(data.data(), "RIFF", 4) || std::memcmp(data.data() + 8, "WAVE", 4)) return false;
+
+  int bits = 0;
+  int format = 0;
+  int channels = 0;
+  std::size_t pos = 12;
+  while (pos + 8 <= data.size())
+  {
+    char const* chunk = data.data() + pos;
+    std::size_t size = read_le(chunk + 4, 4);
+    std::size_t body = pos + 8;
+    if (body + size > data.size()) size = data.size() - body;
+
+    if (!std::memcmp(chunk, "fmt ", 4) && size >= 16)
+    {
+      format = read_le(chunk + 8, 2);
+      channels = read_le(chunk + 10, 2);
+      result.sample_rate = read_le(chunk + 12, 4);
+      bits = read_le(chunk + 22, 2);
+      if (format == wav_format_extensible && size >= 26)
+        format = read_le(chunk + 32, 2);
+    }
+    else if (!std::memcmp(chunk, "data", 4))
+    {
+      if (channels <= 0 || result.sample_rate <= 0) return false;
+      if (format == wav_format_pcm && bits != 16 && bits != 24 && bits != 32) return false;
+      if (format == wav_format_float && bits != 32 && bits != 64) return false;
+      if (format != wav_format_pcm && format != wav_format_float) return false;
+
+      int frame_bytes = channels * bits / 8;
+      int frames = (int)(size / frame_bytes);
+      result.channels.resize(channels, std::vector<float>(frames, 0.0f));
+      for (int f = 0; f < frames; f++)
+        for (int c = 0; c < channels; c++)
+          result.channels[c][f] = read_sample(chunk + 8 + f * frame_bytes + c * bits / 8, format, bits);
+      return frames > 0;
+    }
+
+    // chunks are word aligned
+    pos = body + size + (size & 1);
+  }
+  return false;
+}
+
+}
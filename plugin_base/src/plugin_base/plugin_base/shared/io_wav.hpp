@@ -0,0 +1,18 @@
+#pragma once
+
+#include <vector>
+#include <filesystem>
+
+namespace plugin_base {
+
+// minimal riff/wave reader, e.g. for impulse responses
+// 16/24/32 bit integer pcm and 32/64 bit float, channels are deinterleaved
+struct wav_data
+{
+  int sample_rate = 0;
+  std::vector<std::vector<float>> channels = {};
+};
+
+bool wav_load(std::filesystem::path const& path, wav_data& result);
+
+}
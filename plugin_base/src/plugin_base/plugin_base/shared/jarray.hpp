@@ -2,6 +2,8 @@
 
 #include <plugin_base/shared/utility.hpp>
 #include <vector>
+#include <algorithm>
+#include <functional>
 
 namespace plugin_base {
 
@@ -69,6 +71,8 @@ public:
   { return _data.emplace_back(std::forward<U>(args)...); }
   void fill(int start, int end, elem_type const& val)
   { std::fill(begin() + start, begin() + end, val); }
+  bool is_constant(int start, int end) const
+  { return std::adjacent_find(cbegin() + start, cbegin() + end, std::not_equal_to<elem_type>()) == cbegin() + end; }
   void add_to(int start, int end, jarray& rhs) const
   { for(int f = start; f < end; f++) rhs[f] += (*this)[f]; }
   void copy_to(int start, int end, jarray& rhs) const
@@ -1,4 +1,3 @@
-#include <plugin_base/desc/dims.hpp>
 #include <plugin_base/shared/state.hpp>
 
 namespace plugin_base {
@@ -7,8 +6,28 @@ plugin_state::
 plugin_state(plugin_desc const* desc, bool notify):
 _desc(desc), _notify(notify)
 {
-  plugin_dims dims(*_desc->plugin, desc->plugin->audio_polyphony);
-  _state.resize(dims.module_slot_param_slot);
+  // same order as the global param index, see plugin_desc
+  int start = 0;
+  for (int m = 0; m < desc->plugin->modules.size(); m++)
+  {
+    auto const& module = desc->plugin->modules[m];
+    module_offsets offsets = { start, 0, (int)_param_offsets.size() };
+    for (int p = 0; p < module.params.size(); p++)
+    {
+      _param_offsets.push_back(offsets.stride);
+      offsets.stride += module.params[p].info.slot_count;
+    }
+    start += offsets.stride * module.info.slot_count;
+    _module_offsets.push_back(offsets);
+  }
+  assert(start == desc->param_count);
+  for (int i = 0; i < desc->param_count; i++)
+    assert(flat_index(desc->param_mappings.params[i].topo.module_index, 
+      desc->param_mappings.params[i].topo.module_slot, desc->param_mappings.params[i].topo.param_index,
+      desc->param_mappings.params[i].topo.param_slot) == i);
+
+  _state.resize(desc->param_count);
+  _undo_tracked.resize(desc->param_count, false);
   init(state_init_type::default_, false);
 }
 
@@ -102,13 +121,20 @@ plugin_state::redo_stack()
   return result;
 }
 
+// walk back newest to oldest
 void 
 plugin_state::undo(int index)
 {
   assert(_undo_entries.size() > 0);
   assert(0 < _undo_position - index && _undo_position - index <= _undo_entries.size());
-  _undo_position -= index + 1;
-  copy_from(_undo_entries[_undo_position]->state_before, false);
+  int target = _undo_position - index - 1;
+  for (int e = _undo_position - 1; e >= target; e--)
+  {
+    auto const& deltas = _undo_entries[e]->deltas;
+    for (int d = 0; d < deltas.size(); d++)
+      set_plain_at_index(deltas[d].index, deltas[d].before);
+  }
+  _undo_position = target;
 }
 
 void 
@@ -116,8 +142,31 @@ plugin_state::redo(int index)
 {
   assert(_undo_entries.size() > 0);
   assert(0 <= _undo_position + index && _undo_position + index < _undo_entries.size());
-  copy_from(_undo_entries[_undo_position + index]->state_after, false);
-  _undo_position += index + 1;
+  int target = _undo_position + index + 1;
+  for (int e = _undo_position; e < target; e++)
+  {
+    auto const& deltas = _undo_entries[e]->deltas;
+    for (int d = 0; d < deltas.size(); d++)
+      set_plain_at_index(deltas[d].index, deltas[d].after);
+  }
+  _undo_position = target;
+}
+
+void
+plugin_state::clear_undo_tracking()
+{
+  for (int d = 0; d < _undo_region_deltas.size(); d++)
+    _undo_tracked[_undo_region_deltas[d].index] = false;
+  _undo_region_deltas.clear();
+}
+
+// remember the value before the first write in the region
+void
+plugin_state::track_undo(int index)
+{
+  if (_undo_tracked[index]) return;
+  _undo_tracked[index] = true;
+  _undo_region_deltas.push_back({ index, {}, _state[index] });
 }
 
 void
@@ -127,22 +176,33 @@ plugin_state::discard_undo_region()
   _undo_region = 0;
   _undo_position = 0;
   _undo_entries.clear();
+  clear_undo_tracking();
+}
+
+// plain values are a union, compare the member the param actually uses
+bool
+plugin_state::plain_changed_at_index(int index, plain_value before, plain_value after) const
+{
+  if (desc().param_at_index(index).param->domain.is_real())
+    return before.real() != after.real();
+  return before.step() != after.step();
 }
 
 int
 plugin_state::begin_undo_region()
 {
   int result = _undo_region;
-  if(_undo_region == 0) _undo_state_before = jarray<plain_value, 4>(_state);
+  if(_undo_region == 0) clear_undo_tracking();
   _undo_region++;
   assert(_undo_region > 0);
   return result;
 }
 
+// deltas are only valid in sequence, so a new (non-empty) entry drops the redo stack
 void 
 plugin_state::end_undo_region(int token, std::string const& action, std::string const& item)
 {
-  int const max_undo_size = 32;
+  int const max_undo_size = 256;
   assert(_undo_region > 0);
   _undo_region--;
   assert(token == _undo_region);
@@ -150,8 +210,18 @@ plugin_state::end_undo_region(int token, std::string const& action, std::string
   auto entry = std::make_shared<undo_entry>();
   entry->item = item;
   entry->action = action;
-  entry->state_after = jarray<plain_value, 4>(_state);
-  entry->state_before = jarray<plain_value, 4>(_undo_state_before);
+  for (int d = 0; d < _undo_region_deltas.size(); d++)
+  {
+    auto delta = _undo_region_deltas[d];
+    delta.after = get_plain_at_index(delta.index);
+    if (plain_changed_at_index(delta.index, delta.before, delta.after))
+      entry->deltas.push_back(delta);
+  }
+  clear_undo_tracking();
+
+  // no-op edit, don't add an empty step or lose the redo stack
+  if (entry->deltas.empty()) return;
+  _undo_entries.erase(_undo_entries.begin() + _undo_position, _undo_entries.end());
   _undo_entries.push_back(entry);
   if(_undo_entries.size() > max_undo_size) 
     _undo_entries.erase(_undo_entries.begin());
@@ -169,21 +239,18 @@ plugin_state::text_to_normalized_at_index(
 }
 
 void
-plugin_state::set_plain_at(int m, int mi, int p, int pi, plain_value value)
+plugin_state::set_plain_at_index(int index, plain_value value)
 {
+  if(_undo_region > 0) track_undo(index);
   if(!_notify)
   {
-    _state[m][mi][p][pi] = value;
+    _state[index] = value;
     return;
   }
-  bool changed;
-  if(desc().plugin->modules[m].params[p].domain.is_real())
-    changed = _state[m][mi][p][pi].real() != value.real();
-  else
-    changed = _state[m][mi][p][pi].step() != value.step();
-  _state[m][mi][p][pi] = value;
+  bool changed = plain_changed_at_index(index, _state[index], value);
+  _state[index] = value;
   if (_notify && changed) 
-    state_changed(desc().param_mappings.topo_to_index[m][mi][p][pi], value);
+    state_changed(index, value);
 }
 
 void
@@ -232,22 +299,21 @@ plugin_state::swap_module_with(int index, int source_slot, int target_slot)
     }
 }
 
+// without listeners or undo tracking this is a plain memcpy
 void 
-plugin_state::copy_from(jarray<plain_value, 4> const& other, bool patch_only)
+plugin_state::copy_from(plugin_state const& other, bool patch_only)
 {
-  for (int m = 0; m < desc().plugin->modules.size(); m++)
+  assert(other._state.size() == _state.size());
+  if (!_notify && !patch_only && _undo_region == 0)
   {
-    auto const& module = desc().plugin->modules[m];
-    for (int mi = 0; mi < module.info.slot_count; mi++)
-      for (int p = 0; p < module.params.size(); p++)
-        // optional ignore for per-instance params outside of the patch
-        if (!patch_only || !module.params[p].info.is_per_instance)
-        {
-          auto const& param = module.params[p];
-          for (int pi = 0; pi < param.info.slot_count; pi++)
-            set_plain_at(m, mi, p, pi, other[m][mi][p][pi]);
-        }
+    std::copy(other._state.begin(), other._state.end(), _state.begin());
+    return;
   }
+
+  // optional ignore for per-instance params outside of the patch
+  for (int i = 0; i < _state.size(); i++)
+    if (!patch_only || !desc().param_at_index(i).param->info.is_per_instance)
+      set_plain_at_index(i, other._state[i]);
 }
 
 void
@@ -15,12 +15,20 @@ namespace plugin_base {
 
 enum class state_init_type { empty, minimal, default_ };
 
+// single param change within an undo entry, by global param index
+struct undo_delta
+{
+  int index;
+  plain_value after;
+  plain_value before;
+};
+
+// only the params that actually changed during the undo region
 struct undo_entry
 {
   std::string item;
   std::string action;
-  jarray<plain_value, 4> state_after;
-  jarray<plain_value, 4> state_before;
+  std::vector<undo_delta> deltas;
 };
 
 class state_listener
@@ -37,22 +45,29 @@ public:
   virtual void any_state_changed(int index, plain_value plain) = 0;
 };
 
+// values are stored flat by global param index, topo lookups go through
+// precomputed offsets: module start + slot * module stride + param start + param slot
 class plugin_state final {
+  struct module_offsets { int start; int stride; int params; };
+
   int _undo_region = 0;
   int _undo_position = 0;
   bool const _notify = {};
-  jarray<plain_value, 4> _state = {};
+  std::vector<plain_value> _state = {};
+  std::vector<int> _param_offsets = {};
+  std::vector<module_offsets> _module_offsets = {};
   plugin_desc const* const _desc = {};
-  jarray<plain_value, 4> _undo_state_before = {};
+  std::vector<bool> _undo_tracked = {};
+  std::vector<undo_delta> _undo_region_deltas = {};
   std::vector<std::shared_ptr<undo_entry>> _undo_entries = {};
   std::vector<any_state_listener*> mutable _any_listeners = {};
   std::map<int, std::vector<state_listener*>> mutable _listeners = {};
 
+  void clear_undo_tracking();
+  void track_undo(int index);
+  bool plain_changed_at_index(int index, plain_value before, plain_value after) const;
   void state_changed(int index, plain_value plain) const;
-  plain_value get_plain_at_mapping(param_topo_mapping const& m) const 
-  { return get_plain_at(m.module_index, m.module_slot, m.param_index, m.param_slot); }
-  void set_plain_at_mapping(param_topo_mapping const& m, plain_value value)
-  { set_plain_at(m.module_index, m.module_slot, m.param_index, m.param_slot, value); }
+  int flat_index(int m, int mi, int p, int pi) const;
 
 public:
   plugin_state(plugin_desc const* desc, bool notify);
@@ -68,10 +83,9 @@ public:
   void end_undo_region(int token, std::string const& action, std::string const& item);
 
   plugin_desc const& desc() const { return *_desc; }
-  jarray<plain_value, 4> const& state() const { return _state; }
 
   void init(state_init_type init_type, bool patch_only);
-  void copy_from(jarray<plain_value, 4> const& other, bool patch_only);
+  void copy_from(plugin_state const& other, bool patch_only);
 
   void add_any_listener(any_state_listener* listener) const;
   void remove_any_listener(any_state_listener* listener) const;
@@ -85,15 +99,15 @@ public:
   void move_module_to(int index, int source_slot, int target_slot);
   void swap_module_with(int index, int source_slot, int target_slot);
 
-  void set_plain_at(int m, int mi, int p, int pi, plain_value value);
+  void set_plain_at_index(int index, plain_value value);
+  plain_value get_plain_at_index(int index) const 
+  { return _state[index]; }
+  void set_plain_at(int m, int mi, int p, int pi, plain_value value)
+  { set_plain_at_index(flat_index(m, mi, p, pi), value); }
   plain_value get_plain_at(int m, int mi, int p, int pi) const
-  { return _state[m][mi][p][pi]; }
+  { return _state[flat_index(m, mi, p, pi)]; }
   plain_value get_plain_at(param_topo_mapping m) const
-  { return _state[m.module_index][m.module_slot][m.param_index][m.param_slot]; }
-  plain_value get_plain_at_index(int index) const 
-  { return get_plain_at_mapping(desc().param_mappings.params[index].topo); }
-  void set_plain_at_index(int index, plain_value value) 
-  { set_plain_at_mapping(desc().param_mappings.params[index].topo, value); }
+  { return get_plain_at(m.module_index, m.module_slot, m.param_index, m.param_slot); }
   plain_value get_plain_at_tag(int tag) const 
   { return get_plain_at_index(desc().param_mappings.tag_to_index.at(tag)); }
   void set_plain_at_tag(int tag, plain_value value) 
@@ -142,4 +156,11 @@ public:
   bool text_to_normalized_at_index(bool io, int index, std::string const& textual, normalized_value& normalized) const;
 };
 
+inline int
+plugin_state::flat_index(int m, int mi, int p, int pi) const
+{
+  auto const& offsets = _module_offsets[m];
+  return offsets.start + mi * offsets.stride + _param_offsets[offsets.params + p] + pi;
+}
+
 }
\ No newline at end of file
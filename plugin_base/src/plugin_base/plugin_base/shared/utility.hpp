@@ -41,6 +41,7 @@
 namespace plugin_base {
 
 // wraps a juce fft and retains the output buffer
+// forward/inverse work in-place on 2 * size() floats in juce real-only layout
 class cached_fft
 {
   int const _in_samples;
@@ -50,6 +51,10 @@ class cached_fft
 public:
   cached_fft(int in_samples);
   std::vector<float> const& perform(std::vector<float> const& in);
+
+  int size() const { return _juce_fft.getSize(); }
+  void inverse(float* inout) const { _juce_fft.performRealOnlyInverseTransform(inout); }
+  void forward(float* inout) const { _juce_fft.performRealOnlyForwardTransform(inout, true); }
 };
 
 struct format_basic_config;
@@ -1,5 +1,8 @@
 #include <plugin_base/topo/plugin.hpp>
+#include <plugin_base/shared/io_shared.hpp>
+
 #include <set>
+#include <cctype>
 
 namespace plugin_base {
 
@@ -158,4 +161,29 @@ plugin_topo::presets() const
   return result;
 }
 
+std::vector<impulse_response_item>
+plugin_topo::impulse_responses() const
+{
+  // user-provided, expect wav files directly in the "impulse_responses" folder
+  std::vector<impulse_response_item> result;
+  auto ir_folder = user_data_location(vendor, full_name) / user_folder_impulse_responses;
+  std::error_code error;
+  if (!std::filesystem::is_directory(ir_folder, error)) return {};
+  for (auto const& entry : std::filesystem::directory_iterator{ ir_folder, error })
+  {
+    std::string extension = entry.path().extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    if (entry.is_regular_file(error) && extension == ".wav")
+    {
+      impulse_response_item item;
+      item.path = entry.path().string();
+      item.id = entry.path().filename().string();
+      item.name = entry.path().stem().string();
+      result.push_back(item);
+    }
+  }
+  std::sort(result.begin(), result.end(), [](auto const& l, auto const& r) { return l.name < r.name; });
+  return result;
+}
+
 }
\ No newline at end of file
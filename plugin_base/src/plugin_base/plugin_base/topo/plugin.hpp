@@ -34,6 +34,15 @@ struct preset_item
   std::string group;
 };
 
+// from the user data folder
+// id is the file name, so it stays the same when other files come and go
+struct impulse_response_item
+{
+  std::string id;
+  std::string name;
+  std::string path;
+};
+
 typedef std::function<std::unique_ptr<module_engine>()>
 arpeggiator_factory;
 
@@ -186,6 +195,7 @@ struct plugin_topo final {
   std::vector<preset_item> presets() const;
   std::vector<list_item> preset_list() const;
   std::shared_ptr<gui_submenu> preset_submenu() const;
+  std::vector<impulse_response_item> impulse_responses() const;
 
   PB_PREVENT_ACCIDENTAL_COPY_DEFAULT_CTOR(plugin_topo);
 };
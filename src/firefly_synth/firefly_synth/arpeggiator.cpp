@@ -77,6 +77,40 @@ struct arp_table_note
   { return midi_key < rhs.midi_key; }
 };
 
+// fixed capacity so rebuilding the table never allocates on the audio thread
+struct arp_note_table
+{
+  int count = 0;
+  std::array<arp_table_note, max_active_table_size> notes = {};
+
+  int size() const { return count; }
+  void clear() { count = 0; }
+  arp_table_note* begin() { return notes.data(); }
+  arp_table_note* end() { return notes.data() + count; }
+  arp_table_note& operator[](int i) { assert(0 <= i && i < count); return notes[i]; }
+  arp_table_note const& operator[](int i) const { assert(0 <= i && i < count); return notes[i]; }
+
+  void push_back(arp_table_note note);
+  void insert(int pos, arp_table_note note);
+};
+
+// by value, source may live in the table itself
+inline void
+arp_note_table::push_back(arp_table_note note)
+{
+  assert(count < max_active_table_size);
+  notes[count++] = note;
+}
+
+inline void
+arp_note_table::insert(int pos, arp_table_note note)
+{
+  assert(0 <= pos && pos <= count && count < max_active_table_size);
+  std::copy_backward(begin() + pos, end(), end() + 1);
+  notes[pos] = note;
+  count++;
+}
+
 static std::vector<list_item>
 mod_mode_items()
 {
@@ -131,6 +165,11 @@ public module_engine
   int _prev_jump = -1;
   int _prev_notes = -1;
 
+  // bumped when the held notes or table params change
+  // table is rebuilt when it no longer matches the stamp it was built from
+  std::uint32_t _input_stamp = 0;
+  std::uint32_t _table_stamp = 0;
+
   int _table_pos = -1;
   int _note_remaining = 0;
   int _current_note_length = 0;
@@ -150,7 +189,7 @@ public module_engine
   std::array<int, 128> _note_abs_mapping = {};
   std::array<std::uint32_t, 4> _user_chord_bits = {};
   std::array<arp_user_note, 128> _current_user_chord = {};
-  std::vector<arp_table_note> _current_arp_note_table = {};
+  arp_note_table _current_arp_note_table = {};
 
   int flipped_table_pos() const;
   float current_mod_val(int mod_shape);
@@ -166,7 +205,7 @@ public:
 
   arpeggiator_engine();
 
-  std::vector<arp_table_note> const&
+  arp_note_table const&
   current_arp_note_table() const
   { return _current_arp_note_table; }
 
@@ -485,10 +524,7 @@ arpeggiator_topo(plugin_topo const* topo, int section, gui_position const& pos)
 }         
 
 arpeggiator_engine::
-arpeggiator_engine()
-{
-  _current_arp_note_table.reserve(max_active_table_size);
-}
+arpeggiator_engine() {}
 
 void 
 arpeggiator_engine::hard_reset(std::vector<note_event>& out)
@@ -636,8 +672,7 @@ arpeggiator_engine::build_arp_note_table(
     else
       _current_seed = seed_param;
     _random.seed(_current_seed);
-    // need sort first since random order must be uniquely determined by the seed
-    std::sort(_current_arp_note_table.begin(), _current_arp_note_table.end());
+    // already sorted above, random order must be uniquely determined by the seed
     std::shuffle(_current_arp_note_table.begin(), _current_arp_note_table.end(), _random);
     break;
   case mode_up:
@@ -673,7 +708,7 @@ arpeggiator_engine::build_arp_note_table(
   {
     note_set_count = _current_arp_note_table.size();
     for (int i = 0; i < note_set_count - 2 && _current_arp_note_table.size() < max_active_table_size; i++)
-      _current_arp_note_table.insert(_current_arp_note_table.begin() + 2 + 2 * i, _current_arp_note_table[0]);
+      _current_arp_note_table.insert(2 + 2 * i, _current_arp_note_table[0]);
   }
 }
 
@@ -694,6 +729,8 @@ arpeggiator_engine::reset_audio(
   _prev_jump = -1;
   _prev_notes = -1;
 
+  _input_stamp = 0;
+  _table_stamp = 0;
   _table_pos = -1;
   _note_remaining = 0;
   _current_note_length = 0;
@@ -711,7 +748,7 @@ arpeggiator_engine::reset_audio(
   _note_abs_mapping = {};
   _user_chord_bits = {};
   _current_user_chord = {};
-  _current_arp_note_table = {};
+  _current_arp_note_table.clear();
   _fire_this_round = {};
 }
 
@@ -813,6 +850,8 @@ arpeggiator_engine::process_audio(
   if (type != _prev_type || mode != _prev_mode || flip != _prev_flip || notes != _prev_notes 
     || seed != _prev_seed || jump != _prev_jump || dist != _prev_dist || sync != _prev_sync)
   {
+    if (type != _prev_type || mode != _prev_mode || seed != _prev_seed || jump != _prev_jump)
+      _input_stamp++;
     _prev_type = type;
     _prev_mode = mode;
     _prev_flip = flip;
@@ -825,6 +864,31 @@ arpeggiator_engine::process_audio(
     hard_reset(*out_notes);
   }
 
+  // this assumes notes are ordered by stream pos
+  // only count actual changes to the held set, e.g. not releasing an unheld key
+  // also keep track while off, so switching on picks up what is currently held
+  for (int i = 0; i < in_notes->size(); i++)
+  {
+    std::uint32_t midi_key = std::clamp((*in_notes)[i].id.key, 0, 127);
+    std::uint32_t midi_bit = 1U << (midi_key % 32U);
+    auto& user_note = _current_user_chord[midi_key];
+    if ((*in_notes)[i].type == note_event_type::on)
+    {
+      if (user_note.on && user_note.velocity == (*in_notes)[i].velocity) continue;
+      _user_chord_bits[midi_key / 32] |= midi_bit;
+      user_note.on = true;
+      user_note.velocity = (*in_notes)[i].velocity;
+    }
+    else
+    {
+      if (!user_note.on) continue;
+      _user_chord_bits[midi_key / 32] &= ~midi_bit;
+      user_note.on = false;
+      user_note.velocity = 0.0f;
+    }
+    _input_stamp++;
+  }
+
   if (type == type_off)
   {
     out_notes->insert(out_notes->end(), in_notes->begin(), in_notes->end());
@@ -839,7 +903,7 @@ arpeggiator_engine::process_audio(
   }
   
   // STEP 0: off all current notes
-  bool table_changed = in_notes->size() != 0;
+  bool table_changed = _input_stamp != _table_stamp;
   if (table_changed)
     for (int i = 0; i < 128; i++)
       if (_fire_this_round[i])
@@ -854,24 +918,6 @@ arpeggiator_engine::process_audio(
         out_notes->push_back(off);
       }
 
-  // this assumes notes are ordered by stream pos
-  for (int i = 0; i < in_notes->size(); i++)
-  {
-    std::uint32_t midi_key = std::clamp((*in_notes)[i].id.key, 0, 127);
-    if ((*in_notes)[i].type == note_event_type::on)
-    {
-      _user_chord_bits[midi_key / 32] |= 1U << (midi_key % 32U);
-      _current_user_chord[midi_key].on = true;
-      _current_user_chord[midi_key].velocity = (*in_notes)[i].velocity;
-    }
-    else
-    {
-      _user_chord_bits[midi_key / 32] &= ~(1U << (midi_key % 32U));
-      _current_user_chord[midi_key].on = false;
-      _current_user_chord[midi_key].velocity = 0.0f;
-    }
-  }
-
   if (table_changed)
   {
     // reset to before start, will get picked up
@@ -885,6 +931,7 @@ arpeggiator_engine::process_audio(
     _cv_out_rel_pos = 0.0f;
     _cv_out_abs_note = 0.0f;
     _cv_out_rel_note = 0.0f;
+    _table_stamp = _input_stamp;
     build_arp_note_table(_current_user_chord, type, mode, _current_seed, seed, jump);
   }
 
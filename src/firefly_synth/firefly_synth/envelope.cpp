@@ -265,7 +265,8 @@ render_graph(
   auto const* block = engine->process(module_env, mapping.module_slot, custom_outputs, nullptr, [mapping, &custom_outputs](plugin_block& block) {
     env_engine engine;
     engine.reset_graph(&block, nullptr, nullptr, custom_outputs, nullptr);
-    cv_cv_matrix_mixdown modulation(make_static_cv_matrix_mixdown(block)[module_env][mapping.module_slot]);
+    cv_matrix_mixdown mixdown(make_static_cv_matrix_mixdown(block));
+    cv_cv_matrix_mixdown modulation(mixdown[module_env][mapping.module_slot]);
     engine.process_graph(block, nullptr, nullptr, custom_outputs, &modulation);
   });
   engine->process_end();
@@ -687,6 +688,21 @@ calc_slope_exp_splt(double slope_pos, double splt_bnd, double exp)
   return 1 - std::pow(1 - (slope_pos - splt_bnd) / (1 - splt_bnd), exp) * (1 - splt_bnd);
 }
 
+// single stage of the envelope, branch free so it vectorizes for the linear slope
+template <class CalcSlope> static void
+env_render_span(
+  float* out, int frames, double pos, double pos_step, 
+  double a, double b, double splt_bnd, double exp, CalcSlope calc_slope)
+{
+  if (b == 0)
+  {
+    std::fill(out, out + frames, (float)a);
+    return;
+  }
+  for (int i = 0; i < frames; i++)
+    out[i] = (float)(a + b * calc_slope(std::min(pos + i * pos_step, 1.0), splt_bnd, exp));
+}
+
 void
 env_engine::reset_audio(
   plugin_block const* block,
@@ -1031,6 +1047,7 @@ void env_engine::process_mono_type_sync_trigger_mode(plugin_block& block, cv_cv_
     }
   }
 
+  mono_note_cursor mono_notes(block.state.mono_note_stream);
   for (int f = block.start_frame; f < block.end_frame; f++)
   {
     if ((!is_mseg && _dahdsr_stage == env_stage::end) || (is_mseg && _mseg_stage == _mseg_seg_count + mseg_stage_end))
@@ -1073,7 +1090,8 @@ void env_engine::process_mono_type_sync_trigger_mode(plugin_block& block, cv_cv_
       // the last note in a monophonic section
       if constexpr (Trigger != trigger_legato)
       {
-        if(block.state.mono_note_stream[f].event_type == mono_note_stream_event::on)
+        mono_note_state const* mono_note = mono_notes.at(f);
+        if(mono_note && mono_note->event_type == mono_note_stream_event::on)
         {
           if(!is_mseg && _dahdsr_stage < env_stage::release ||
             is_mseg && _mseg_stage <= _mseg_sustain_point)
@@ -1149,13 +1167,21 @@ void env_engine::process_mono_type_sync_trigger_mode(plugin_block& block, cv_cv_
       stage_seconds = _mseg_time[_mseg_stage];
     }
 
-    float out = 0;
-    _stage_pos = std::min(_stage_pos, stage_seconds);
-    double slope_pos = _stage_pos / stage_seconds;
+    // curve for the current stage is out = a + b * slope(pos) with pos linear in time
+    // and current/multitrig level tracking out for the attack/decay part of the envelope
+    double a = 0;
+    double b = 0;
+    double exp = 0;
+    double splt_bnd = 0;
+    bool track_current = true;
+    bool track_multitrig = true;
     
-    if (stage_seconds == 0) 
-      out = _current_level;
-
+    if (stage_seconds == 0)
+    {
+      a = _current_level;
+      track_current = false;
+      track_multitrig = false;
+    }
     else
     {
       if constexpr (Mode != mode_mseg)
@@ -1163,26 +1189,41 @@ void env_engine::process_mono_type_sync_trigger_mode(plugin_block& block, cv_cv_
         switch (_dahdsr_stage)
         {
         case env_stage::delay:
-          if constexpr (Trigger == trigger_multi)
-            out = _current_level = _multitrig_level;
-          else
-            _current_level = _multitrig_level = out = 0;
+          a = Trigger == trigger_multi ? _multitrig_level : 0;
           break;
         case env_stage::attack:
+          exp = _dahdsr_slp_att_exp;
+          splt_bnd = _dahdsr_slp_att_splt_bnd;
           if constexpr (Trigger == trigger_multi)
-            out = _current_level = _multitrig_level + (1 - _multitrig_level) * calc_slope(slope_pos, _dahdsr_slp_att_splt_bnd, _dahdsr_slp_att_exp);
+          {
+            a = _multitrig_level;
+            b = 1 - _multitrig_level;
+            track_multitrig = false;
+          }
           else
-            _current_level = _multitrig_level = out = calc_slope(slope_pos, _dahdsr_slp_att_splt_bnd, _dahdsr_slp_att_exp);
+            b = 1;
+          break;
+        case env_stage::hold: a = 1; break;
+        case env_stage::release:
+          a = _current_level;
+          b = -_current_level;
+          exp = _dahdsr_slp_rls_exp;
+          splt_bnd = _dahdsr_slp_rls_splt_bnd;
+          track_current = false;
+          track_multitrig = false;
+          break;
+        case env_stage::decay: 
+          a = 1;
+          b = _dahdsr_stn - 1;
+          exp = _dahdsr_slp_dcy_exp;
+          splt_bnd = _dahdsr_slp_dcy_splt_bnd;
           break;
-        case env_stage::hold: _current_level = _multitrig_level = out = 1; break;
-        case env_stage::release: out = _current_level * (1 - calc_slope(slope_pos, _dahdsr_slp_rls_splt_bnd, _dahdsr_slp_rls_exp)); break;
-        case env_stage::decay: _current_level = _multitrig_level = out = _dahdsr_stn + (1 - _dahdsr_stn) * (1 - calc_slope(slope_pos, _dahdsr_slp_dcy_splt_bnd, _dahdsr_slp_dcy_exp)); break;
         default: assert(false); stage_seconds = 0; break;
         }
       }
       else
       {
-        float prev_y;
+        double prev_y;
         if (_mseg_stage == 0)
         {
           if constexpr (Trigger == trigger_multi)
@@ -1195,23 +1236,50 @@ void env_engine::process_mono_type_sync_trigger_mode(plugin_block& block, cv_cv_
           prev_y = _mseg_stage == _mseg_sustain_point + 1 ? _current_level : _mseg_y[_mseg_stage - 1];
         }
 
-        out = prev_y + (_mseg_y[_mseg_stage] - prev_y) * calc_slope(slope_pos, 0.0f, _mseg_exp[_mseg_stage]);
-        if(_mseg_stage <= _mseg_sustain_point)
-          _current_level = _multitrig_level = out;
+        a = prev_y;
+        b = _mseg_y[_mseg_stage] - prev_y;
+        exp = _mseg_exp[_mseg_stage];
+        track_current = _mseg_stage <= _mseg_sustain_point;
+        track_multitrig = track_current;
       }
     }
 
-    check_unipolar(out);
+    // render up to the end of the stage, the release frame or the next retrigger in one go
+    // graph fast-forward needs to see every frame
+    int frames = 1;
+    double const frame_time = 1.0 / block.sample_rate;
+    if (stage_seconds > 0 && !_is_ffwd_run_for_graph)
+    {
+      double stage_frames = std::ceil((stage_seconds - _stage_pos) / frame_time);
+      frames = (int)std::clamp(stage_frames, 1.0, (double)(block.end_frame - f));
+      if (block.voice->state.release_frame > f)
+        frames = std::min(frames, block.voice->state.release_frame - f);
+      if constexpr (Monophonic && Trigger != trigger_legato)
+        frames = mono_notes.next_on(f, f + frames) - f;
+    }
+
+    _stage_pos = std::min(_stage_pos, stage_seconds);
+    double pos = stage_seconds == 0 ? 0 : _stage_pos / stage_seconds;
+    double pos_step = stage_seconds == 0 ? 0 : frame_time / stage_seconds;
+    double last = b == 0 ? a : a + b * calc_slope(std::min(pos + (frames - 1) * pos_step, 1.0), splt_bnd, exp);
+    if (track_current) _current_level = last;
+    if (track_multitrig) _multitrig_level = last;
+
+    check_unipolar(last);
     check_unipolar(_current_level);
     check_unipolar(_multitrig_level);
-    block.state.own_cv[0][0][f] = _filter.next(out);
-    _stage_pos += 1.0 / block.sample_rate;
-    
-    _total_pos += 1.0 / block.sample_rate;
+    float* out = block.state.own_cv[0][0].data().data() + f;
+    env_render_span(out, frames, pos, pos_step, a, b, splt_bnd, exp, calc_slope);
+    for (int i = 0; i < frames; i++)
+      out[i] = _filter.next(out[i]);
+
+    _stage_pos += frames * frame_time;
+    _total_pos += frames * frame_time;
     if (_is_ffwd_run_for_graph)
       if (_total_pos >= _ffwd_target_total_pos && _ffwd_stopped_at_samples == -1)
         _ffwd_stopped_at_samples = _total_pos * block.sample_rate;
 
+    f += frames - 1;
     if (_stage_pos < stage_seconds) continue;
 
     _stage_pos = 0;
@@ -1,10 +1,13 @@
 #include <plugin_base/dsp/engine.hpp>
 #include <plugin_base/dsp/utility.hpp>
+#include <plugin_base/dsp/convolver.hpp>
+#include <plugin_base/dsp/delay_line.hpp>
 #include <plugin_base/helpers/dsp.hpp>
 #include <plugin_base/topo/plugin.hpp>
 #include <plugin_base/topo/support.hpp>
 #include <plugin_base/dsp/oversampler.hpp>
 #include <plugin_base/dsp/graph_engine.hpp>
+#include <plugin_base/shared/io_wav.hpp>
 #include <plugin_base/shared/io_plugin.hpp>
 
 #include <firefly_synth/svf.hpp>
@@ -13,7 +16,12 @@
 
 #include <cmath>        
 #include <array>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <semaphore>
 #include <algorithm>
+#include <condition_variable>
 
 using namespace plugin_base;
 
@@ -31,8 +39,18 @@ static double const flt_max_res = 0.99;
 static double const flt_min_freq = 20;
 static double const flt_max_freq = 20000;
 static double const dly_max_sec = 10;
+static int const dly_max_taps = 8;
 static double const dly_max_filter_time_ms = 500;
 
+static float const conv_max_sec = 10;
+static int const conv_graph_max_points = 1000;
+static int const conv_resample_zero_crossings = 16;
+static int const conv_resample_table_resolution = 256;
+static double const conv_resample_rolloff = 0.9;
+
+// svf coefficients are updated at control rate and interpolated in between
+static int const flt_control_rate = 16;
+
 static float const reverb_gain = 0.015f;
 static float const reverb_dry_scale = 2.0f;
 static float const reverb_wet_scale = 3.0f;
@@ -44,6 +62,18 @@ static float const reverb_spread = 23.0f / 44100.0f;
 static int const meq_flt_count = 5;
 static int const reverb_comb_count = 8;
 static int const reverb_allpass_count = 4;
+static int const reverb_comb_lanes = reverb_comb_count * 2;
+
+static int const fdn_max_lines = 16;
+static float const fdn_in_gain = 0.5f;
+static float const fdn_min_rt60 = 0.25f;
+static float const fdn_rt60_range = 32.0f;
+// primes, 8-line mode takes every other one
+static float const fdn_line_length[fdn_max_lines] = {
+  1009.0f / 44100.0f, 1109.0f / 44100.0f, 1223.0f / 44100.0f, 1327.0f / 44100.0f,
+  1447.0f / 44100.0f, 1559.0f / 44100.0f, 1693.0f / 44100.0f, 1823.0f / 44100.0f,
+  1979.0f / 44100.0f, 2137.0f / 44100.0f, 2311.0f / 44100.0f, 2503.0f / 44100.0f,
+  2699.0f / 44100.0f, 2917.0f / 44100.0f, 3163.0f / 44100.0f, 3413.0f / 44100.0f };
 static float const reverb_allpass_length[reverb_allpass_count] = {
   556.0f / 44100.0f, 441.0f / 44100.0f, 341.0f / 44100.0f, 225.0f / 44100.0f };
 static float const reverb_comb_length[reverb_comb_count] = {
@@ -51,20 +81,21 @@ static float const reverb_comb_length[reverb_comb_count] = {
   1422.0f / 44100.0f, 1491.0f / 44100.0f, 1557.0f / 44100.0f, 1617.0f / 44100.0f };
 
 enum { dly_mode_fdbk, dly_mode_multi };
+enum { fdn_lines_8, fdn_lines_16 };
 enum { meq_mode_serial, meq_mode_parallel };
 enum { dist_mode_no_filter, dist_mode_filt_to_shape, dist_mode_shape_to_filt };
 enum { dist_over_1, dist_over_2, dist_over_4 };
 enum { comb_mode_feedforward, comb_mode_feedback, comb_mode_both };
-enum { type_off, type_svf, type_cmb, type_dst, type_dsf_dst, type_meq, type_delay, type_reverb };
+enum { type_off, type_svf, type_cmb, type_dst, type_dsf_dst, type_meq, type_delay, type_reverb, type_fdn_reverb, type_conv };
 enum { dist_clip_hard, dist_clip_tanh, dist_clip_sin, dist_clip_tsq, dist_clip_cube, dist_clip_inv, dist_clip_exp };
 enum { svf_mode_lpf, svf_mode_hpf, svf_mode_bpf, svf_mode_bsf, svf_mode_apf, svf_mode_peq, svf_mode_bll, svf_mode_lsh, svf_mode_hsh };
 enum { meq_flt_mode_off, meq_flt_mode_lpf, meq_flt_mode_hpf, meq_flt_mode_bpf, meq_flt_mode_bsf, meq_flt_mode_apf, meq_flt_mode_peq, meq_flt_mode_bll, meq_flt_mode_lsh, meq_flt_mode_hsh };
 enum { section_main, section_svf_left, section_svf_right, section_comb_left, section_comb_right, section_dist_flt, section_dist_mid, 
-  section_dist_right, section_meq, section_delay_sync, section_delay_left, section_delay_right, section_reverb_left, section_reverb_right };
+  section_dist_right, section_meq, section_delay_sync, section_delay_left, section_delay_right, section_reverb_left, section_reverb_right, section_conv };
 
 enum { scratch_dly_fdbk_l, scratch_dly_fdbk_r, scratch_dly_fdbk_count };
 enum { scratch_reverb_damp, scratch_reverb_size, scratch_reverb_in, scratch_reverb_count };
-enum { scratch_dly_multi_hold, scratch_dly_multi_time, scratch_dly_multi_sprd, scratch_dly_multi_count };
+enum { scratch_dly_multi_hold, scratch_dly_multi_time, scratch_dly_multi_sprd, scratch_dly_multi_lo, scratch_dly_multi_hi, scratch_dly_multi_wet_l, scratch_dly_multi_wet_r, scratch_dly_multi_count };
 enum { scratch_dist_x, scratch_dist_y, scratch_dist_gain_raw, scratch_dist_svf_freq, scratch_dist_clip_exp, scratch_dist_dsf_dist, scratch_dist_dsf_parts, scratch_dist_count };
 enum { scratch_flt_stvar_freq, scratch_flt_stvar_kbd, scratch_flt_stvar_gain, scratch_flt_stvar_count };
 enum { scratch_flt_comb_dly_plus, scratch_flt_comb_gain_plus, scratch_flt_comb_dly_min, scratch_flt_comb_gain_min, scratch_flt_comb_gain_count };
@@ -84,11 +115,13 @@ enum { param_type,
   param_dly_mode, param_dly_sync, param_dly_amt, param_dly_mix, param_dly_sprd, param_dly_hold_time, param_dly_hold_tempo,
   param_dly_fdbk_time_l, param_dly_fdbk_tempo_l, param_dly_fdbk_time_r, param_dly_fdbk_tempo_r,
   param_dly_multi_taps, param_dly_multi_time, param_dly_multi_tempo,
-  param_reverb_mix, param_reverb_spread, param_reverb_apf, param_reverb_size, param_reverb_damp
+  param_reverb_mix, param_reverb_spread, param_reverb_apf, param_reverb_size, param_reverb_damp,
+  param_reverb_quality, param_conv_ir, param_conv_mix
 };
 
 static bool svf_has_gain(int svf_mode) { return svf_mode >= svf_mode_bll; }
 static bool type_is_dst(int type) { return type == type_dst || type == type_dsf_dst; }
+static bool type_is_reverb(int type) { return type == type_reverb || type == type_fdn_reverb; }
 static constexpr bool meq_has_gain(int meq_flt_mode) { return meq_flt_mode >= meq_flt_mode_bll; }
 static bool comb_has_feedback(int comb_mode) { return comb_mode == comb_mode_feedback || comb_mode == comb_mode_both; }
 static bool comb_has_feedforward(int comb_mode) { return comb_mode == comb_mode_feedforward || comb_mode == comb_mode_both; }
@@ -106,6 +139,27 @@ type_items(bool global)
   if(!global) return result;
   result.emplace_back("{789D430C-9636-4FFF-8C75-11B839B9D80D}", "Delay");
   result.emplace_back("{7BB990E6-9A61-4C9F-BDAC-77D1CC260017}", "Reverb");
+  result.emplace_back("{25D7D1D1-051C-4996-87FF-888197E6CEA9}", "FDN Reverb");
+  result.emplace_back("{579083FB-AC65-4BA1-A5ED-106C4A8463B5}", "Convolution");
+  return result;
+}
+
+static std::vector<list_item>
+conv_ir_items(std::vector<impulse_response_item> const& irs)
+{
+  std::vector<list_item> result;
+  result.emplace_back("{2E6FAEAF-AB4A-481E-9340-3D80E774C67C}", "Off");
+  for (int i = 0; i < irs.size(); i++)
+    result.emplace_back(irs[i].id, irs[i].name);
+  return result;
+}
+
+static std::vector<list_item>
+reverb_quality_items()
+{
+  std::vector<list_item> result;
+  result.emplace_back("{61E2D88C-603C-4462-BC03-D201FB0DF9AA}", "8 Lines");
+  result.emplace_back("{DBDAEF60-B850-4490-8DB0-AD0B961B8234}", "16 Lines");
   return result;
 }
 
@@ -205,6 +259,173 @@ dist_over_items()
   return result;
 }
 
+// windowed sinc, band limited to the lower of both nyquists (minus some rolloff)
+// so downsampling does not alias. kernel is tabulated over the sinc argument
+// and linearly interpolated, blackman window over conv_resample_zero_crossings
+static std::vector<float>
+resample_impulse_response(std::vector<float> const& in, double step, int frames)
+{
+  if (step == 1.0) return std::vector<float>(in.begin(), in.begin() + frames);
+
+  int const zc = conv_resample_zero_crossings;
+  int const res = conv_resample_table_resolution;
+  double const cutoff = std::min(1.0, 1.0 / step) * conv_resample_rolloff;
+  std::vector<float> table(zc * res + 2, 0.0f);
+  for (int i = 0; i <= zc * res; i++)
+  {
+    double u = i / (double)res;
+    double sinc = i == 0 ? 1.0 : std::sin(pi64 * u) / (pi64 * u);
+    double window = 0.42 + 0.5 * std::cos(pi64 * u / zc) + 0.08 * std::cos(2.0 * pi64 * u / zc);
+    table[i] = (float)(cutoff * sinc * window);
+  }
+
+  // half width in input samples
+  int const size = (int)in.size();
+  double const half_width = zc / cutoff;
+  std::vector<float> result(frames, 0.0f);
+  for (int f = 0; f < frames; f++)
+  {
+    double sum = 0;
+    double pos = f * step;
+    int first = std::max(0, (int)std::ceil(pos - half_width));
+    int last = std::min(size - 1, (int)std::floor(pos + half_width));
+    for (int i = first; i <= last; i++)
+    {
+      double u = std::fabs(pos - i) * cutoff * res;
+      int t = (int)u;
+      if (t >= zc * res) continue;
+      float w = (float)(u - t);
+      sum += in[i] * ((1.0f - w) * table[t] + w * table[t + 1]);
+    }
+    result[f] = (float)sum;
+  }
+  return result;
+}
+
+// resampled to the engine rate, at most 2 channels, cut at conv_max_sec
+// normalized to unit energy on the loudest channel so wet level is about dry level
+static std::vector<std::vector<float>>
+load_impulse_response(std::string const& path, float sample_rate)
+{
+  wav_data wav;
+  if (!wav_load(path, wav)) return {};
+
+  double max_energy = 0;
+  std::vector<std::vector<float>> result;
+  double step = wav.sample_rate / (double)sample_rate;
+  for (int c = 0; c < std::min(2, (int)wav.channels.size()); c++)
+  {
+    double energy = 0;
+    auto const& in = wav.channels[c];
+    int frames = std::min((int)(in.size() / step), (int)(conv_max_sec * sample_rate));
+    std::vector<float> out(resample_impulse_response(in, step, frames));
+    for (int f = 0; f < frames; f++)
+      energy += out[f] * out[f];
+    max_energy = std::max(max_energy, energy);
+    result.push_back(std::move(out));
+  }
+
+  if (max_energy == 0) return {};
+  float scale = (float)(1.0 / std::sqrt(max_energy));
+  for (int c = 0; c < result.size(); c++)
+    for (int f = 0; f < result[c].size(); f++)
+      result[c][f] *= scale;
+  return result;
+}
+
+// prepared convolution, no convolvers means no (valid) impulse response
+struct conv_ir
+{
+  std::array<std::unique_ptr<partitioned_convolver>, 2> convolvers = {};
+};
+
+// handshake between audio thread and worker, audio thread bumps serial to request
+// an ir and picks up ready when retired was collected, worker does all allocation
+struct conv_request
+{
+  std::atomic<int> serial = 0;
+  std::atomic<int> ir_index = -1;
+  std::atomic<conv_ir*> ready = nullptr;
+  std::atomic<conv_ir*> retired = nullptr;
+  int served = 0;
+};
+
+// delay lines are only allocated while the delay is selected
+struct dly_lines
+{
+  std::array<delay_line, 2> lines = {};
+};
+
+// audio thread tells the worker whether it needs lines (or has them already)
+// and hands back lines it no longer needs in retired
+enum { dly_need_none, dly_need_lines, dly_need_have };
+struct dly_request
+{
+  std::atomic<int> need = dly_need_none;
+  std::atomic<dly_lines*> ready = nullptr;
+  std::atomic<dly_lines*> retired = nullptr;
+};
+
+class fx_engine;
+
+// job queue for the stuff that should not happen on the audio thread: loading 
+// impulse responses and allocating/freeing delay lines. lives in the topo, so
+// it is a single thread shared by the global fx engines of all plugin instances.
+// sleeps until an engine posts a job, the lock only guards the engine list and 
+// which engine is being worked on, the actual work runs outside of it.
+// all communication with the audio thread is through atomic pointer handoff
+class fx_worker
+{
+  std::mutex _mutex = {};
+  std::thread _thread = {};
+  std::atomic<bool> _stop = false;
+  std::counting_semaphore<> _wake{ 0 };
+  std::condition_variable _idle = {};
+  fx_engine* _busy = nullptr;
+  std::vector<fx_engine*> _engines = {};
+  std::vector<impulse_response_item> const _irs;
+
+  void run();
+  fx_engine* next_job();
+
+public:
+  PB_PREVENT_ACCIDENTAL_COPY(fx_worker);
+  fx_worker(std::vector<impulse_response_item> const& irs): _irs(irs) {}
+  ~fx_worker();
+
+  // audio thread
+  void post() { _wake.release(); }
+
+  void attach(fx_engine* engine);
+  void detach(fx_engine* engine);
+  std::vector<impulse_response_item> const& irs() const { return _irs; }
+};
+
+fx_worker::
+~fx_worker()
+{
+  _stop.store(true);
+  _wake.release();
+  if (_thread.joinable()) _thread.join();
+}
+
+void
+fx_worker::attach(fx_engine* engine)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _engines.push_back(engine);
+  if (!_thread.joinable()) _thread = std::thread([this] { run(); });
+}
+
+// don't pull the engine out from under a running job
+void
+fx_worker::detach(fx_engine* engine)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _engines.erase(std::remove(_engines.begin(), _engines.end(), engine), _engines.end());
+  _idle.wait(lock, [this, engine] { return _busy != engine; });
+}
+
 class fx_state_converter:
 public state_converter
 {
@@ -226,25 +447,35 @@ class fx_engine:
 public module_engine {  
 
   bool const _global;
+  float const _sample_rate;
+  fx_worker* const _worker;
+  std::atomic<bool> _job_posted = false;
+  void post_job();
 
   // svf
   state_var_filter _svf;
 
   // comb
-  int _comb_pos = {};
-  int _comb_samples = {};
-  std::vector<double> _comb_in[2];
-  std::vector<double> _comb_out[2];
+  std::array<delay_line, 2> _comb_in = {};
+  std::array<delay_line, 2> _comb_out = {};
 
   // delay
-  int _dly_pos = {};
-  int const _dly_capacity = {};
-  jarray<float, 2> _dly_buffer = {};
+  // 10 seconds stereo is too much to keep around for every slot, so lines are
+  // only allocated while the delay is selected. when it is selected on activation
+  // they are allocated right away, so renders start with a working delay. switching
+  // to delay later has the worker allocate them (output is dry until they arrive),
+  // switching away hands them back. graphs have no worker and allocate in place
+  dly_request _dly_request;
+  dly_lines* _dly_current = nullptr;
+  void alloc_dly_lines();
+  void update_dly_lines(int type);
+  void background_dly();
 
   // distortion with fixed dc filter @20hz
   // and resonant lp filter in the oversampling stage
   dc_filter _dst_dc;
   state_var_filter _dst_svf;
+  dsf_generator<float> _dst_dsf = {};
   oversampler<1> _dst_oversampler;
 
   // multi-band eq
@@ -252,14 +483,53 @@ public module_engine {
 
   // reverb
   // https://github.com/sinshu/freeverb
-  std::array<std::array<float, reverb_comb_count>, 2> _rev_comb_filter = {};
-  std::array<std::array<std::int32_t, reverb_comb_count>, 2> _rev_comb_pos = {};
-  std::array<std::array<std::vector<float>, reverb_comb_count>, 2> _rev_comb = {};
-  std::array<std::array<std::int32_t, reverb_allpass_count>, 2> _rev_allpass_pos = {};
-  std::array<std::array<std::vector<float>, reverb_allpass_count>, 2> _rev_allpass = {};
+  // combs of both channels run as 16 lanes over a single interleaved buffer
+  // with a shared write position, lengths are padded to the same power of 2
+  // so each frame writes one contiguous row of 16 and the filter update vectorizes
+  // like delay_line, reset only forgets how many rows were written (fill)
+  int _rev_comb_pos = 0;
+  int _rev_comb_mask = 0;
+  int _rev_comb_fill = 0;
+  std::vector<float> _rev_comb = {};
+  std::array<int, reverb_comb_lanes> _rev_comb_length = {};
+  std::array<float, reverb_comb_lanes> _rev_comb_filter = {};
+  std::array<std::array<int, reverb_allpass_count>, 2> _rev_allpass_length = {};
+  std::array<std::array<delay_line, reverb_allpass_count>, 2> _rev_allpass = {};
+
+  // fdn reverb
+  // 8 or 16 lines in the same interleaved layout as the reverb combs
+  // feedback matrix is hadamard, done in-place as a fast walsh-hadamard transform
+  // line count 0 means start over on the next block, 
+  // which just forgets how many rows were written (fill)
+  int _fdn_pos = 0;
+  int _fdn_mask = 0;
+  int _fdn_fill = 0;
+  int _fdn_lines = 0;
+  std::vector<float> _fdn_buffer = {};
+  std::array<int, fdn_max_lines> _fdn_length = {};
+  std::array<float, fdn_max_lines> _fdn_gain = {};
+  std::array<float, fdn_max_lines> _fdn_filter = {};
+
+  // convolution
+  // impulse response selected on activation is loaded right away, changing it
+  // later has the worker load and prepare it and output is dry until it arrives
+  // reset keeps the impulse response and only clears the convolver history
+  conv_request _conv_request;
+  conv_ir* _conv_current = nullptr;
+  int _conv_ir_index = -1;
+
+  void background_conv();
+  std::unique_ptr<conv_ir> prepare_conv_ir(int index) const;
+  void process_conv(plugin_block& block,
+    jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation);
 
   void process_reverb(plugin_block& block,
     jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation);
+  void process_fdn_reverb(plugin_block& block,
+    jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation);
+  template <int Lines>
+  void process_fdn_reverb_lines(plugin_block& block,
+    jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation);
 
   void process_delay(plugin_block& block,
     jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation);
@@ -272,6 +542,8 @@ public module_engine {
   template <bool Sync>
   void process_dly_multi_sync(plugin_block& block, 
     jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation);
+  void process_dly_multi_block(plugin_block& block, jarray<float, 2> const& audio_in,
+    jarray<float, 1> const& mix_curve, int tap_count, float const* tap_delay, float const* tap_gain);
 
   void process_comb(plugin_block& block,
     jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation);
@@ -324,7 +596,12 @@ public module_engine {
 
 public:
   PB_PREVENT_ACCIDENTAL_COPY(fx_engine);
-  fx_engine(bool global, int sample_rate, int max_frame_count);
+  fx_engine(bool global, int sample_rate, int max_frame_count, fx_worker* worker);
+  ~fx_engine();
+
+  // worker thread only
+  bool take_job() { return _job_posted.exchange(false); }
+  void background_work() { background_conv(); background_dly(); }
 
   void reset_audio(plugin_block const*,
     std::vector<note_event> const* in_notes,
@@ -338,6 +615,41 @@ public:
   void process(plugin_block& block, cv_audio_matrix_mixdown const* modulation, jarray<float, 2> const* audio_in);
 };
 
+fx_engine*
+fx_worker::next_job()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (auto* engine : _engines)
+    if (engine->take_job())
+      return _busy = engine;
+  return nullptr;
+}
+
+void
+fx_worker::run()
+{
+  while (true)
+  {
+    _wake.acquire();
+    if (_stop.load()) return;
+    while (auto* engine = next_job())
+    {
+      engine->background_work();
+      std::lock_guard<std::mutex> lock(_mutex);
+      _busy = nullptr;
+      _idle.notify_all();
+    }
+  }
+}
+
+// audio thread, wake up the worker once until it picked up the job
+void
+fx_engine::post_job()
+{
+  if (!_job_posted.exchange(true))
+    _worker->post();
+}
+
 // tack some cached buffers for fft onto graph_engine
 class fx_graph_engine:
 public graph_engine
@@ -386,13 +698,80 @@ make_graph_engine(plugin_desc const* desc)
   return std::make_unique<fx_graph_engine>(desc, params);
 }
 
+// impulse response plot, peak per bucket, normalized
+// decoded once per impulse response, not on every repaint
+struct conv_graph_points
+{
+  bool loaded = false;
+  float seconds = 0.0f;
+  std::vector<jarray<float, 1>> series = {};
+};
+
+// ui thread only
+typedef std::vector<conv_graph_points> conv_graph_cache;
+
+static void
+load_conv_graph_points(std::string const& path, conv_graph_points& result)
+{
+  wav_data wav;
+  result.loaded = true;
+  if (!wav_load(path, wav) || wav.channels.empty()) return;
+
+  float max_amp = 0.0f;
+  int frames = std::min((int)wav.channels[0].size(), (int)(conv_max_sec * wav.sample_rate));
+  int bucket = std::max(1, (frames + conv_graph_max_points - 1) / conv_graph_max_points);
+  std::vector<jarray<float, 1>> series;
+  for (int c = 0; c < 2; c++)
+  {
+    std::vector<float> points;
+    auto const& in = wav.channels[std::min(c, (int)wav.channels.size() - 1)];
+    for (int b = 0; b < frames; b += bucket)
+    {
+      float peak = 0.0f;
+      for (int f = b; f < std::min(frames, b + bucket); f++)
+        if (std::fabs(in[f]) > std::fabs(peak)) peak = in[f];
+      max_amp = std::max(max_amp, std::fabs(peak));
+      points.push_back(peak);
+    }
+    series.push_back(jarray<float, 1>(points));
+  }
+
+  if (max_amp == 0.0f) max_amp = 1.0f;
+  for (int c = 0; c < 2; c++)
+    for (int i = 0; i < series[c].size(); i++)
+      series[c][i] /= max_amp;
+  result.series = std::move(series);
+  result.seconds = frames / (float)wav.sample_rate;
+}
+
+// impulse response that is in the list but could not be loaded
+// (deleted or broken since startup) shows up as missing, engine runs dry
+static graph_data
+render_conv_graph(
+  plugin_state const& state, param_topo_mapping const& mapping, 
+  std::vector<impulse_response_item> const& irs, conv_graph_cache& cache)
+{
+  int index = state.get_plain_at(mapping.module_index, mapping.module_slot, param_conv_ir, 0).step() - 1;
+  if (index < 0 || index >= irs.size())
+    return graph_data(graph_data_type::off, { "Convolution" });
+
+  auto& points = cache[index];
+  if (!points.loaded) load_conv_graph_points(irs[index].path, points);
+  if (points.series.empty())
+    return graph_data(graph_data_type::off, { "IR Missing" });
+  std::string partition = float_to_string(points.seconds, 2) + " Sec";
+  return graph_data(jarray<float, 2>(points.series), 0.25f, true, { partition });
+}
+
 static graph_data
 render_graph(
   plugin_state const& state, graph_engine* engine, int param, 
-  param_topo_mapping const& mapping, std::vector<mod_out_custom_state> const& custom_outputs)
+  param_topo_mapping const& mapping, std::vector<mod_out_custom_state> const& custom_outputs,
+  std::vector<impulse_response_item> const& irs, conv_graph_cache& conv_cache)
 {
   int type = state.get_plain_at(mapping.module_index, mapping.module_slot, param_type, 0).step();
   if(type == type_off) return graph_data(graph_data_type::off, { state.desc().plugin->modules[mapping.module_index].info.tag.menu_display_name });
+  if(type == type_conv) return render_conv_graph(state, mapping, irs, conv_cache);
 
   int frame_count = -1;
   int sample_rate = -1;
@@ -436,7 +815,7 @@ render_graph(
   else
   {
     // need some more input than delay for reverb to have visual effect
-    assert(type == type_reverb);
+    assert(type_is_reverb(type));
     int length = 450;
     sample_rate = 300;
     frame_count = 3000;
@@ -455,7 +834,7 @@ render_graph(
   auto const* block = engine->process(
     mapping.module_index, mapping.module_slot, custom_outputs, nullptr, [mapping, sample_rate, frame_count, &audio_in](plugin_block& block) {
     bool global = mapping.module_index == module_gfx;
-    fx_engine engine(global, sample_rate, frame_count);
+    fx_engine engine(global, sample_rate, frame_count, nullptr);
     engine.reset_audio(&block, nullptr, nullptr);
     cv_audio_matrix_mixdown modulation(make_static_cv_matrix_mixdown(block));
     engine.process<true>(block, &modulation, &audio_in);
@@ -486,7 +865,7 @@ render_graph(
 
   // delay or reverb - do some autosizing so it looks pretty
   // note: we re-use dly_max_sec as max plotting time for the reverb
-  assert(type == type_delay || type == type_reverb);
+  assert(type == type_delay || type_is_reverb(type));
   float max_amp = 0.0f;
   int last_significant_frame = 0;
   for (int f = 0; f < frame_count; f++)
@@ -517,7 +896,7 @@ render_graph(
     float one_bar_length = timesig_to_time(120, { 1, 1 });
     partition = float_to_string(length / one_bar_length, 2) + " Bar";
   }
-  bool stroke_with_area = type == type_reverb;
+  bool stroke_with_area = type_is_reverb(type);
   float stroke = type == type_delay? 1.0f: 0.25f;
   return graph_data(jarray<float, 2>(
     std::vector<jarray<float, 1>>({ jarray<float, 1>(left), jarray<float, 1>(right) })), 
@@ -584,6 +963,14 @@ fx_state_converter::handle_invalid_param_value(
     }
   }
 
+  // impulse responses are user-provided files, the one in the patch 
+  // may not be there (anymore), don't guess at a replacement, just turn it off
+  if (_global && new_param_id == _desc->plugin->modules[module_gfx].params[param_conv_ir].info.tag.id)
+  {
+    new_value = _desc->raw_to_plain_at(module_gfx, param_conv_ir, 0);
+    return true;
+  }
+
   // Max distortion oversampling got reduced from 8x to 4x.
   // note: param ids are equal between vfx/gfx, gfx just has more
   if (handler.old_version() < plugin_version{ 1, 7, 2 })
@@ -665,12 +1052,12 @@ fx_state_converter::post_process_existing(load_handler const& handler, plugin_st
 }
 
 module_topo
-fx_topo(int section, gui_position const& pos, bool global, bool is_fx)
+fx_topo(int section, gui_position const& pos, bool global, bool is_fx, plugin_topo const* plugin)
 {
   auto voice_info = make_topo_info("{4901E1B1-BFD6-4C85-83C4-699DC27C6BC4}", true, "Voice FX", "Voice FX", "VFX", module_vfx, 10);
   voice_info.description = "Per-voice FX module with state variable filter, comb filter and distortion.";
   auto global_info = make_topo_info("{31EF3492-FE63-4A59-91DA-C2B4DD4A8891}", true, "Global FX", "Global FX", "GFX", module_gfx, 10);
-  global_info.description = "Global FX module with state variable filter, comb filter, distortion, delay and reverb.";
+  global_info.description = "Global FX module with state variable filter, comb filter, distortion, delay, reverb, FDN reverb and convolution.";
   module_stage stage = global ? module_stage::output : module_stage::voice;
   auto const info = topo_info(global ? global_info : voice_info);
 
@@ -681,14 +1068,22 @@ fx_topo(int section, gui_position const& pos, bool global, bool is_fx)
   result.gui.tabbed_name = "FX";
   result.gui.is_drag_mod_source = true;
  
+  // worker is shared by all global slots
+  std::shared_ptr<fx_worker> worker;
+  std::vector<impulse_response_item> irs;
+  if (global) irs = plugin->impulse_responses();
+  if (global) worker = std::make_shared<fx_worker>(irs);
+  auto conv_cache = std::make_shared<conv_graph_cache>(irs.size());
+
   result.graph_engine_factory = make_graph_engine;
   if (global) result.default_initializer = [is_fx](auto& s) { init_global_default(s); };
   if (!global) result.default_initializer = init_voice_default;
-  result.graph_renderer = render_graph;
+  result.graph_renderer = [irs, conv_cache](auto const& state, auto* engine, int param, auto const& mapping, auto const& custom_outputs) {
+    return render_graph(state, engine, param, mapping, custom_outputs, irs, *conv_cache); };
   result.gui.menu_handler_factory = [global](plugin_state* state) {
     return make_audio_routing_menu_handler(state, global); };
-  result.engine_factory = [global](auto const&, int sample_rate, int max_frame_count) {
-    return std::make_unique<fx_engine>(global, sample_rate, max_frame_count); };
+  result.engine_factory = [global, worker](auto const&, int sample_rate, int max_frame_count) {
+    return std::make_unique<fx_engine>(global, sample_rate, max_frame_count, worker.get()); };
   result.state_converter_factory = [global](auto desc) { return std::make_unique<fx_state_converter>(desc, global); };
 
   result.sections.emplace_back(make_param_section(section_main,
@@ -708,6 +1103,8 @@ fx_topo(int section, gui_position const& pos, bool global, bool is_fx)
   type.gui.submenu->indices.push_back(type_meq);
   if (global) type.gui.submenu->indices.push_back(type_delay);
   if (global) type.gui.submenu->indices.push_back(type_reverb);
+  if (global) type.gui.submenu->indices.push_back(type_fdn_reverb);
+  if (global) type.gui.submenu->indices.push_back(type_conv);
   type.info.description = "Selects the effect type.";
 
   auto& svf_mode = result.params.emplace_back(make_param(
@@ -1149,7 +1546,7 @@ fx_topo(int section, gui_position const& pos, bool global, bool is_fx)
   delay_fdbk_tempo_r.info.description = "Feedback delay right length in bars.";
   auto& delay_taps = result.params.emplace_back(make_param(
     make_topo_info("{27572912-0A8E-4A97-9A54-379829E8E794}", true, "Multi Delay Tap Count", "Taps", "MDly Taps", param_dly_multi_taps, 1),
-    make_param_dsp_input(false, param_automate::none), make_domain_step(1, 8, 4, 0),
+    make_param_dsp_input(false, param_automate::none), make_domain_step(1, dly_max_taps, 4, 0),
     make_param_gui_single(section_delay_right, gui_edit_type::hslider, { 1, 0 },
       make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
   delay_taps.gui.bindings.visible.bind_params({ param_type, param_dly_mode }, [](auto const& vs) { return vs[1] == dly_mode_multi; });
@@ -1178,19 +1575,19 @@ fx_topo(int section, gui_position const& pos, bool global, bool is_fx)
     make_param_dsp_accurate(param_automate::modulate), make_domain_percentage_identity(0.5, 0, true),
     make_param_gui_single(section_main, gui_edit_type::hslider, { 1, 0 },
       make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
-  reverb_mix.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_reverb; });
-  reverb_mix.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_reverb; });
+  reverb_mix.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return type_is_reverb(vs[0]); });
+  reverb_mix.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return type_is_reverb(vs[0]); });
   reverb_mix.info.description = "Reverb dry/wet control.";  
   auto& reverb_left = result.sections.emplace_back(make_param_section(section_reverb_left,
     make_topo_tag_basic("{92EFDFE7-41C5-4E9D-9BE6-DC56965C1C0D}", "Reverb Left"),
     make_param_section_gui({ 0, 1, 2, 2 }, { { 1, 1 }, { gui_dimension::auto_size_all, 1 } }, gui_label_edit_cell_split::horizontal)));
-  reverb_left.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_reverb; });
+  reverb_left.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return type_is_reverb(vs[0]); });
   auto& reverb_sprd = result.params.emplace_back(make_param(
     make_topo_info("{0D138920-65D2-42E9-98C5-D8FEC5FD2C55}", true, "Reverb Spread", "Spread", "Reverb Spread", param_reverb_spread, 1),
     make_param_dsp_accurate(param_automate::modulate), make_domain_percentage_identity(0.5, 0, true),
     make_param_gui_single(section_reverb_left, gui_edit_type::hslider, { 0, 0 },
       make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
-  reverb_sprd.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_reverb; });
+  reverb_sprd.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return type_is_reverb(vs[0]); });
   reverb_sprd.info.description = "Reverb stereo-spread control.";
   auto& reverb_apf = result.params.emplace_back(make_param(
     make_topo_info("{09DF58B0-4155-47F2-9AEB-927B2D8FD250}", true, "Reverb APF", "APF", "Reverb APF", param_reverb_apf, 1),
@@ -1198,71 +1595,155 @@ fx_topo(int section, gui_position const& pos, bool global, bool is_fx)
     make_param_gui_single(section_reverb_left, gui_edit_type::hslider, { 1, 0 },
       make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
   reverb_apf.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_reverb; });
+  reverb_apf.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_reverb; });
   reverb_apf.info.description = "Reverb all-pass filter amount.";
 
   auto& reverb_right = result.sections.emplace_back(make_param_section(section_reverb_right,
     make_topo_tag_basic("{EB2AE24C-1AF8-49A9-B4CA-B1F974362DD2}", "Reverb Right"),
     make_param_section_gui({ 0, 3, 2, 2 }, { { 1, 1 }, { gui_dimension::auto_size_all, 1 } }, gui_label_edit_cell_split::horizontal)));
-  reverb_right.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_reverb; });
+  reverb_right.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return type_is_reverb(vs[0]); });
   auto& reverb_size = result.params.emplace_back(make_param(
     make_topo_info("{E413FA18-420D-4510-80D1-54E2A0ED4CB2}", true, "Reverb Size", "Size", "Reverb Size", param_reverb_size, 1),
     make_param_dsp_accurate(param_automate::modulate), make_domain_percentage_identity(0.8, 0, true),
     make_param_gui_single(section_reverb_right, gui_edit_type::hslider, { 0, 0 },
       make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
-  reverb_size.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_reverb; });
-  reverb_size.info.description = "Reverb room size.";
+  reverb_size.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return type_is_reverb(vs[0]); });
+  reverb_size.info.description = "Reverb room size. For the FDN reverb, this controls decay time.";
   auto& reverb_damp = result.params.emplace_back(make_param(
     make_topo_info("{44EE5538-9920-4F39-A68E-51E86E96943B}", true, "Reverb Damping", "Damp", "Reverb Damp", param_reverb_damp, 1),
     make_param_dsp_accurate(param_automate::modulate), make_domain_percentage_identity(0.8, 0, true),
     make_param_gui_single(section_reverb_right, gui_edit_type::hslider, { 1, 0 },
       make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
-  reverb_damp.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_reverb; });
+  reverb_damp.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return type_is_reverb(vs[0]); });
   reverb_damp.info.description = "Reverb damping factor.";
 
+  auto& reverb_quality = result.params.emplace_back(make_param(
+    make_topo_info("{1AF42F58-38B6-40D0-8385-51999DE286D5}", true, "Reverb Quality", "Quality", "Reverb Quality", param_reverb_quality, 1),
+    make_param_dsp_input(false, param_automate::none), make_domain_item(reverb_quality_items(), "16 Lines"),
+    make_param_gui_single(section_reverb_left, gui_edit_type::list, { 1, 0 },
+      make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
+  reverb_quality.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_fdn_reverb; });
+  reverb_quality.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_fdn_reverb; });
+  reverb_quality.info.description = "FDN reverb delay line count. 16 lines give a denser tail at about twice the cost.";
+
+  auto& conv_section = result.sections.emplace_back(make_param_section(section_conv,
+    make_topo_tag_basic("{F4A32B9C-043C-4179-BC39-BBA4592060C9}", "Convolution"),
+    make_param_section_gui({ 0, 1, 2, 4 }, { { 1, 1 }, { gui_dimension::auto_size_all, 1 } }, gui_label_edit_cell_split::horizontal)));
+  conv_section.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_conv; });
+  auto& conv_ir = result.params.emplace_back(make_param(
+    make_topo_info("{FAC26B64-6D64-4C7C-9BA6-F4AF9F30183D}", true, "Convolution IR", "IR", "Conv IR", param_conv_ir, 1),
+    make_param_dsp_input(false, param_automate::none), make_domain_item(conv_ir_items(irs), ""),
+    make_param_gui_single(section_conv, gui_edit_type::autofit_list, { 0, 0 },
+      make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
+  conv_ir.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_conv; });
+  conv_ir.info.description = std::string("Selects the impulse response from the WAV files in the impulse_responses folder in the user data folder. ") +
+    "Patches refer to them by file name. When the file is not there, the convolution is turned off on load, or passes the dry signal when it went missing later.";
+  auto& conv_mix = result.params.emplace_back(make_param(
+    make_topo_info("{CB652D78-24B3-4598-9A96-EF028B07A6E8}", true, "Convolution Mix", "Mix", "Conv Mix", param_conv_mix, 1),
+    make_param_dsp_accurate(param_automate::modulate), make_domain_percentage_identity(1.0, 0, true),
+    make_param_gui_single(section_main, gui_edit_type::hslider, { 1, 0 },
+      make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
+  conv_mix.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_conv; });
+  conv_mix.gui.bindings.visible.bind_params({ param_type }, [](auto const& vs) { return vs[0] == type_conv; });
+  conv_mix.info.description = "Convolution dry/wet control.";
+
   return result;
 }
 
 template <int SVFMode>
-static void init_svf(state_var_filter& flt, double w, double res, double gn)
-{
-  if constexpr (SVFMode == svf_mode_lpf) flt.init_lpf(w, res);
-  else if constexpr (SVFMode == svf_mode_hpf) flt.init_hpf(w, res);
-  else if constexpr (SVFMode == svf_mode_bpf) flt.init_bpf(w, res);
-  else if constexpr (SVFMode == svf_mode_bsf) flt.init_bsf(w, res);
-  else if constexpr (SVFMode == svf_mode_apf) flt.init_apf(w, res);
-  else if constexpr (SVFMode == svf_mode_peq) flt.init_peq(w, res);
-  else if constexpr (SVFMode == svf_mode_bll) flt.init_bll(w, res, gn);
-  else if constexpr (SVFMode == svf_mode_lsh) flt.init_lsh(w, res, gn);
-  else if constexpr (SVFMode == svf_mode_hsh) flt.init_hsh(w, res, gn);
+static void init_svf(state_var_filter_coeffs& coeffs, double w, double res, double gn)
+{
+  if constexpr (SVFMode == svf_mode_lpf) coeffs.init_lpf(w, res);
+  else if constexpr (SVFMode == svf_mode_hpf) coeffs.init_hpf(w, res);
+  else if constexpr (SVFMode == svf_mode_bpf) coeffs.init_bpf(w, res);
+  else if constexpr (SVFMode == svf_mode_bsf) coeffs.init_bsf(w, res);
+  else if constexpr (SVFMode == svf_mode_apf) coeffs.init_apf(w, res);
+  else if constexpr (SVFMode == svf_mode_peq) coeffs.init_peq(w, res);
+  else if constexpr (SVFMode == svf_mode_bll) coeffs.init_bll(w, res, gn);
+  else if constexpr (SVFMode == svf_mode_lsh) coeffs.init_lsh(w, res, gn);
+  else if constexpr (SVFMode == svf_mode_hsh) coeffs.init_hsh(w, res, gn);
   else assert(false);
 }
 
+// coefficients at the end of each control rate period, linear interpolation in between
+// if all inputs are constant for the block, coefficients are calculated only once
+template <class CoeffsAt, class Process> static void
+process_svf_control_rate(
+  state_var_filter& flt, int start_frame, int end_frame, 
+  bool block_constant, CoeffsAt coeffs_at, Process process)
+{
+  if (block_constant)
+  {
+    flt.init_ramp(coeffs_at(start_frame), 0);
+    for (int f = start_frame; f < end_frame; f++)
+      process(f);
+    return;
+  }
+
+  for (int f0 = start_frame; f0 < end_frame; f0 += flt_control_rate)
+  {
+    int f1 = std::min(f0 + flt_control_rate, end_frame);
+    flt.init_ramp(coeffs_at(f1 - 1), f1 - f0);
+    for (int f = f0; f < f1; f++)
+    {
+      process(f);
+      flt.next_ramp();
+    }
+  }
+}
+
+fx_engine::
+~fx_engine()
+{
+  if (_worker) _worker->detach(this);
+  delete _conv_current;
+  delete _conv_request.ready.exchange(nullptr);
+  delete _conv_request.retired.exchange(nullptr);
+  delete _dly_current;
+  delete _dly_request.ready.exchange(nullptr);
+  delete _dly_request.retired.exchange(nullptr);
+}
+
 fx_engine::
-fx_engine(bool global, int sample_rate, int max_frame_count) :
-_global(global), _dly_capacity(sample_rate * dly_max_sec), 
+fx_engine(bool global, int sample_rate, int max_frame_count, fx_worker* worker) :
+_global(global), _sample_rate(sample_rate), _worker(worker),
 _dst_oversampler(max_frame_count)
 { 
-  _comb_samples = comb_max_ms * sample_rate * 0.001;
-  _comb_in[0] = std::vector<double>(_comb_samples, 0.0);
-  _comb_in[1] = std::vector<double>(_comb_samples, 0.0);
-  _comb_out[0] = std::vector<double>(_comb_samples, 0.0);
-  _comb_out[1] = std::vector<double>(_comb_samples, 0.0);
+  if (_worker) _worker->attach(this);
+
+  for (int c = 0; c < 2; c++)
+  {
+    _comb_in[c].init(comb_max_ms * sample_rate * 0.001);
+    _comb_out[c].init(comb_max_ms * sample_rate * 0.001);
+  }
   
   if(!global) return;
-  _dly_buffer.resize(jarray<int, 1>(2, _dly_capacity));
+  int rev_comb_rows = 0;
   for (int i = 0; i < reverb_comb_count; i++)
   {
-    float comb_length_l = reverb_comb_length[i] * sample_rate;
-    float comb_length_r = (reverb_comb_length[i] + reverb_spread) * sample_rate;
-    _rev_comb[0][i] = std::vector<float>((int)comb_length_l);
-    _rev_comb[1][i] = std::vector<float>((int)comb_length_r);
+    _rev_comb_length[i] = (int)(reverb_comb_length[i] * sample_rate);
+    _rev_comb_length[reverb_comb_count + i] = (int)((reverb_comb_length[i] + reverb_spread) * sample_rate);
+    rev_comb_rows = std::max(rev_comb_rows, _rev_comb_length[reverb_comb_count + i] + 1);
   }
+  rev_comb_rows = (int)next_pow2(rev_comb_rows);
+  _rev_comb_mask = rev_comb_rows - 1;
+  _rev_comb = std::vector<float>(rev_comb_rows * reverb_comb_lanes, 0.0f);
+
+  int fdn_rows = 0;
+  for (int l = 0; l < fdn_max_lines; l++)
+  {
+    _fdn_length[l] = (int)(fdn_line_length[l] * sample_rate);
+    fdn_rows = std::max(fdn_rows, _fdn_length[l] + 1);
+  }
+  fdn_rows = (int)next_pow2(fdn_rows);
+  _fdn_mask = fdn_rows - 1;
+  _fdn_buffer = std::vector<float>(fdn_rows * fdn_max_lines, 0.0f);
   for (int i = 0; i < reverb_allpass_count; i++)
   {
-    float apf_length_l = reverb_allpass_length[i] * sample_rate;
-    float apf_length_r = (reverb_allpass_length[i] + reverb_spread) * sample_rate;
-    _rev_allpass[0][i] = std::vector<float>((int)apf_length_l);
-    _rev_allpass[1][i] = std::vector<float>((int)apf_length_r);
+    _rev_allpass_length[0][i] = (int)(reverb_allpass_length[i] * sample_rate);
+    _rev_allpass_length[1][i] = (int)((reverb_allpass_length[i] + reverb_spread) * sample_rate);
+    for (int c = 0; c < 2; c++)
+      _rev_allpass[c][i].init(_rev_allpass_length[c][i]);
   }
 }
 
@@ -1273,9 +1754,8 @@ fx_engine::reset_audio(
   std::vector<note_event>* out_notes)
 {
   _svf.clear();
-  _dly_pos = 0;
-  _comb_pos = 0;
   _dst_svf.clear();
+  _dst_dsf.reset();
   _dst_dc.init(block->sample_rate, 20);
   
   for (int i = 0; i < meq_flt_count; i++)
@@ -1284,34 +1764,44 @@ fx_engine::reset_audio(
   auto const& block_auto = block->state.own_block_automation;
   int type = block_auto[param_type][0].step();
   if (type == type_cmb)
-  {
-    std::fill(_comb_in[0].begin(), _comb_in[0].end(), 0.0f);
-    std::fill(_comb_in[1].begin(), _comb_in[1].end(), 0.0f);
-    std::fill(_comb_out[0].begin(), _comb_out[0].end(), 0.0f);
-    std::fill(_comb_out[1].begin(), _comb_out[1].end(), 0.0f);
-  }    
+    for (int c = 0; c < 2; c++)
+    {
+      _comb_in[c].clear();
+      _comb_out[c].clear();
+    }
 
   if(!_global) return;
-  if (type == type_delay) 
+  _fdn_lines = 0;
+
+  // global engines only get reset on activation, so not on the audio thread
+  int conv_index = block_auto[param_conv_ir][0].step() - 1;
+  if (type == type_conv && _worker && conv_index != _conv_ir_index)
+  {
+    delete _conv_current;
+    _conv_ir_index = conv_index;
+    _conv_current = prepare_conv_ir(conv_index).release();
+  }
+  else if (type == type_conv && _conv_current)
+    for (int c = 0; c < 2; c++)
+      if (_conv_current->convolvers[c])
+        _conv_current->convolvers[c]->clear();
+
+  if (type == type_delay && !_dly_current)
   {
-    _dly_buffer[0].fill(0);
-    _dly_buffer[1].fill(0);
+    alloc_dly_lines();
+    _dly_request.need.store(dly_need_have);
   }
+  else if (type == type_delay)
+    for (int c = 0; c < 2; c++)
+      _dly_current->lines[c].clear();
   if (type == type_reverb)
+  {
+    _rev_comb_fill = 0;
+    _rev_comb_filter.fill(0.0f);
     for(int c = 0; c < 2; c++)
-    {
-      for (int i = 0; i < reverb_comb_count; i++)
-      {
-        _rev_comb_pos[c][i] = 0;
-        _rev_comb_filter[c][i] = 0.0f;
-        std::fill(_rev_comb[c][i].begin(), _rev_comb[c][i].end(), 0.0f);
-      }
       for (int i = 0; i < reverb_allpass_count; i++)
-      {
-        _rev_allpass_pos[c][i] = 0;
-        std::fill(_rev_allpass[c][i].begin(), _rev_allpass[c][i].end(), 0.0f);
-      }
-    }
+        _rev_allpass[c][i].clear();
+  }
 }
 
 template <bool Graph> void
@@ -1326,6 +1816,7 @@ fx_engine::process(plugin_block& block,
   }
    
   int type = block.state.own_block_automation[param_type][0].step();  
+  if (_global) update_dly_lines(type);
   if(type == type_off)
   {
     for (int c = 0; c < 2; c++)
@@ -1343,6 +1834,8 @@ fx_engine::process(plugin_block& block,
   case type_cmb: process_comb(block, *audio_in, *modulation); break;
   case type_delay: process_delay(block, *audio_in, *modulation); break;
   case type_reverb: process_reverb(block, *audio_in, *modulation); break;
+  case type_fdn_reverb: process_fdn_reverb(block, *audio_in, *modulation); break;
+  case type_conv: process_conv(block, *audio_in, *modulation); break;
   case type_dst: case type_dsf_dst: process_dist<Graph>(block, *audio_in, *modulation); break;
   default: assert(false); break;
   }
@@ -1393,63 +1886,28 @@ void fx_engine::process_comb_mode(plugin_block& block,
     block.normalized_to_raw_block<domain_type::linear>(this_module, param_comb_gain_plus, gain_plus_curve_norm, gain_plus_curve);
   }
 
+  float const ms_to_samples = block.sample_rate * 0.001f;
   for (int f = block.start_frame; f < block.end_frame; f++)
   {
-    float gain_min = 0;
-    float dly_min_t = 0;
-    int dly_min_samples_0 = 0;
-    int dly_min_samples_1 = 0;
-
-    float gain_plus = 0;
-    float dly_plus_t = 0;
-    int dly_plus_samples_0 = 0;
-    int dly_plus_samples_1 = 0;
-
-    if constexpr (Feedback)
-    {
-      gain_min = gain_min_curve[f];
-      float dly_min = dly_min_curve[f];
-      float dly_min_samples_t = dly_min * block.sample_rate * 0.001;
-      dly_min_t = dly_min_samples_t - (int)dly_min_samples_t;
-      dly_min_samples_0 = (int)dly_min_samples_t;
-      dly_min_samples_1 = (int)dly_min_samples_t + 1;
-    }
-
-    if constexpr (Feedforward)
-    {
-      gain_plus = gain_plus_curve[f];
-      float dly_plus = dly_plus_curve[f];
-      float dly_plus_samples_t = dly_plus * block.sample_rate * 0.001;
-      dly_plus_t = dly_plus_samples_t - (int)dly_plus_samples_t;
-      dly_plus_samples_0 = (int)dly_plus_samples_t;
-      dly_plus_samples_1 = (int)dly_plus_samples_t + 1;
-    }
+    float dly_min_samples = 0;
+    float dly_plus_samples = 0;
+    if constexpr (Feedback) dly_min_samples = dly_min_curve[f] * ms_to_samples;
+    if constexpr (Feedforward) dly_plus_samples = dly_plus_curve[f] * ms_to_samples;
 
     for (int c = 0; c < 2; c++)
     {
       float min = 0;
       float plus = 0;
-
-      // double mod is needed to not go negative
       if constexpr(Feedback)
-      {
-        float min0 = _comb_out[c][(((_comb_pos - dly_min_samples_0) % _comb_samples) + _comb_samples) % _comb_samples];
-        float min1 = _comb_out[c][(((_comb_pos - dly_min_samples_1) % _comb_samples) + _comb_samples) % _comb_samples];
-        min = ((1 - dly_min_t) * min0 + dly_min_t * min1) * gain_min;
-      }
-      
+        min = _comb_out[c].read_linear(dly_min_samples) * gain_min_curve[f];
       if constexpr(Feedforward)
-      {
-        float plus0 = _comb_in[c][(((_comb_pos - dly_plus_samples_0) % _comb_samples) + _comb_samples) % _comb_samples];
-        float plus1 = _comb_in[c][(((_comb_pos - dly_plus_samples_1) % _comb_samples) + _comb_samples) % _comb_samples];
-        plus = ((1 - dly_plus_t) * plus0 + dly_plus_t * plus1) * gain_plus;
-      }
+        plus = _comb_in[c].read_linear(dly_plus_samples) * gain_plus_curve[f];
       
-      _comb_in[c][_comb_pos] = audio_in[c][f];
-      _comb_out[c][_comb_pos] = audio_in[c][f] + plus + min * feedback_factor;
-      block.state.own_audio[0][0][c][f] = _comb_out[c][_comb_pos];
+      float out = audio_in[c][f] + plus + min * feedback_factor;
+      _comb_in[c].write(audio_in[c][f]);
+      _comb_out[c].write(out);
+      block.state.own_audio[0][0][c][f] = out;
     }
-    _comb_pos = (_comb_pos + 1) % _comb_samples;
   }
 }
 
@@ -1478,45 +1936,239 @@ fx_engine::process_reverb(plugin_block& block,
     scratch_size[f] = (std::cbrt(size_curve[f]) * reverb_room_scale) + reverb_room_offset;
   }
 
-  // Apply reverb per channel.
-  for (int c = 0; c < 2; c++)
-    for (int f = block.start_frame; f < block.end_frame; f++)
+  // Combs for L and R in one go, then allpasses and final mix.
+  // Final output depends on L/R both, keep them in locals until the end.
+  auto& out = block.state.own_audio[0][0];
+  float* comb_buffer = _rev_comb.data();
+  for (int f = block.start_frame; f < block.end_frame; f++)
+  {
+    float in = scratch_in[f];
+    float damp = scratch_damp[f];
+    float size = scratch_size[f];
+    float* comb_row = comb_buffer + _rev_comb_pos * reverb_comb_lanes;
+
+    std::array<float, reverb_comb_lanes> comb;
+    for (int l = 0; l < reverb_comb_lanes; l++)
     {
-      block.state.own_audio[0][0][c][f] = 0.0f;
-      for (int i = 0; i < reverb_comb_count; i++)
-      {
-        int pos = _rev_comb_pos[c][i];
-        float comb = _rev_comb[c][i][pos];
-        int length = _rev_comb[c][i].size();
-        _rev_comb_filter[c][i] = (comb * (1.0f - scratch_damp[f])) + (_rev_comb_filter[c][i] * scratch_damp[f]);
-        _rev_comb[c][i][pos] = scratch_in[f] + (_rev_comb_filter[c][i] * scratch_size[f]);
-        _rev_comb_pos[c][i] = (pos + 1) % length;
-        block.state.own_audio[0][0][c][f] += comb;
-      }
+      float val = comb_buffer[((_rev_comb_pos - _rev_comb_length[l]) & _rev_comb_mask) * reverb_comb_lanes + l];
+      comb[l] = _rev_comb_length[l] <= _rev_comb_fill ? val : 0.0f;
+    }
+    for (int l = 0; l < reverb_comb_lanes; l++)
+    {
+      _rev_comb_filter[l] = (comb[l] * (1.0f - damp)) + (_rev_comb_filter[l] * damp);
+      comb_row[l] = in + (_rev_comb_filter[l] * size);
+    }
+    _rev_comb_pos = (_rev_comb_pos + 1) & _rev_comb_mask;
+    _rev_comb_fill += _rev_comb_fill <= _rev_comb_mask;
 
-      for (int i = 0; i < reverb_allpass_count; i++)
+    float rev[2] = { 0.0f, 0.0f };
+    for (int i = 0; i < reverb_comb_count; i++)
+    {
+      rev[0] += comb[i];
+      rev[1] += comb[reverb_comb_count + i];
+    }
+
+    float apf = apf_curve[f] * 0.5f;
+    for (int i = 0; i < reverb_allpass_count; i++)
+      for (int c = 0; c < 2; c++)
       {
-        float output = block.state.own_audio[0][0][c][f];
-        int pos = _rev_allpass_pos[c][i];
-        float allpass = _rev_allpass[c][i][pos];
-        int length = _rev_allpass[c][i].size();
-        block.state.own_audio[0][0][c][f] = -block.state.own_audio[0][0][c][f] + allpass;
-        _rev_allpass[c][i][pos] = output + (allpass * apf_curve[f] * 0.5f);
-        _rev_allpass_pos[c][i] = (pos + 1) % length;
+        float output = rev[c];
+        float allpass = _rev_allpass[c][i].read(_rev_allpass_length[c][i]);
+        rev[c] = -output + allpass;
+        _rev_allpass[c][i].write(output + (allpass * apf));
       }
-    }
 
-  // Final output depends on L/R both.
-  for (int f = block.start_frame; f < block.end_frame; f++)
-  {
     float wet = mix_curve[f] * reverb_wet_scale;
     float dry = (1.0f - mix_curve[f]) * reverb_dry_scale;
     float wet1 = wet * (spread_curve[f] / 2.0f + 0.5f);
     float wet2 = wet * ((1.0f - spread_curve[f]) / 2.0f);
-    float out_l = block.state.own_audio[0][0][0][f] * wet1 + block.state.own_audio[0][0][1][f] * wet2;
-    float out_r = block.state.own_audio[0][0][1][f] * wet1 + block.state.own_audio[0][0][0][f] * wet2;
-    block.state.own_audio[0][0][0][f] = out_l + audio_in[0][f] * dry;
-    block.state.own_audio[0][0][1][f] = out_r + audio_in[1][f] * dry;
+    out[0][f] = rev[0] * wet1 + rev[1] * wet2 + audio_in[0][f] * dry;
+    out[1][f] = rev[1] * wet1 + rev[0] * wet2 + audio_in[1][f] * dry;
+  }
+}
+
+void
+fx_engine::background_conv()
+{
+  delete _conv_request.retired.exchange(nullptr);
+  int serial = _conv_request.serial.load(std::memory_order_acquire);
+  if (serial == _conv_request.served) return;
+  _conv_request.served = serial;
+
+  // replaces the previous one if audio thread did not pick it up yet
+  auto ir = prepare_conv_ir(_conv_request.ir_index.load(std::memory_order_relaxed));
+  delete _conv_request.ready.exchange(ir.release());
+}
+
+std::unique_ptr<conv_ir>
+fx_engine::prepare_conv_ir(int index) const
+{
+  auto result = std::make_unique<conv_ir>();
+  auto const& irs = _worker->irs();
+  if (index < 0 || index >= irs.size()) return result;
+  auto channels = load_impulse_response(irs[index].path, _sample_rate);
+  for (int c = 0; c < 2 && channels.size(); c++)
+    result->convolvers[c] = std::make_unique<partitioned_convolver>(channels[std::min(c, (int)channels.size() - 1)]);
+  return result;
+}
+
+void
+fx_engine::process_conv(plugin_block& block,
+  jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation)
+{
+  // item 0 is off
+  auto& out = block.state.own_audio[0][0];
+  int index = block.state.own_block_automation[param_conv_ir][0].step() - 1;
+  if (_worker && index != _conv_ir_index)
+  {
+    _conv_ir_index = index;
+    _conv_request.ir_index.store(index, std::memory_order_relaxed);
+    _conv_request.serial.fetch_add(1, std::memory_order_release);
+    post_job();
+  }
+
+  // swap in a freshly prepared one, worker frees the old one
+  if (_conv_request.retired.load() == nullptr)
+    if (auto* ready = _conv_request.ready.exchange(nullptr))
+    {
+      _conv_request.retired.store(_conv_current);
+      post_job();
+      _conv_current = ready;
+    }
+
+  if (_conv_current == nullptr || !_conv_current->convolvers[0])
+  {
+    for (int c = 0; c < 2; c++)
+      audio_in[c].copy_to(block.start_frame, block.end_frame, out[c]);
+    return;
+  }
+
+  auto const& mix_curve = *modulation[module_gfx][block.module_slot][param_conv_mix][0];
+  for (int c = 0; c < 2; c++)
+  {
+    auto& convolver = *_conv_current->convolvers[c];
+    for (int f = block.start_frame; f < block.end_frame; f++)
+      out[c][f] = mix_signal(mix_curve[f], audio_in[c][f], convolver.next(audio_in[c][f]));
+  }
+}
+
+void
+fx_engine::process_fdn_reverb(plugin_block& block,
+  jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation)
+{
+  int quality = block.state.own_block_automation[param_reverb_quality][0].step();
+  switch (quality)
+  {
+  case fdn_lines_8: process_fdn_reverb_lines<8>(block, audio_in, modulation); break;
+  case fdn_lines_16: process_fdn_reverb_lines<16>(block, audio_in, modulation); break;
+  default: assert(false); break;
+  }
+}
+
+// https://ccrma.stanford.edu/~jos/pasp/FDN_Reverberation.html
+// per frame: gather all delayed lines, tap the output, damp and scale by the decay gains, 
+// mix through the hadamard matrix and write back one contiguous row together with the input
+// even lines feed and tap the left channel, odd lines the right channel
+template <int Lines>
+void fx_engine::process_fdn_reverb_lines(plugin_block& block,
+  jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation)
+{
+  static_assert(Lines == 8 || Lines == 16);
+  float const norm = 1.0f / std::sqrt((float)Lines);
+  float const in_gain = fdn_in_gain / std::sqrt(Lines / 2.0f);
+  float const log_db60 = -3.0f * std::log(10.0f);
+
+  auto const& mix_curve = *modulation[module_gfx][block.module_slot][param_reverb_mix][0];
+  auto const& size_curve = *modulation[module_gfx][block.module_slot][param_reverb_size][0];
+  auto const& damp_curve = *modulation[module_gfx][block.module_slot][param_reverb_damp][0];
+  auto const& spread_curve = *modulation[module_gfx][block.module_slot][param_reverb_spread][0];
+
+  std::array<int, Lines> length;
+  for (int l = 0; l < Lines; l++)
+    length[l] = _fdn_length[Lines == fdn_max_lines ? l : 2 * l + 1];
+
+  // per-line gain for the decay time at frame f, includes matrix normalization
+  auto gains_at = [&](int f, float* gains) {
+    float rt60 = fdn_min_rt60 * std::pow(fdn_rt60_range, size_curve[f]);
+    float decay = log_db60 / (rt60 * block.sample_rate);
+    for (int l = 0; l < Lines; l++)
+      gains[l] = std::exp(decay * length[l]) * norm;
+  };
+
+  // row layout depends on the line count, so switching starts over too
+  if (_fdn_lines != Lines)
+  {
+    _fdn_fill = 0;
+    _fdn_lines = Lines;
+    _fdn_filter.fill(0.0f);
+    gains_at(block.start_frame, _fdn_gain.data());
+  }
+
+  // gains at control rate, linear interpolation in between
+  auto& out = block.state.own_audio[0][0];
+  float* buffer = _fdn_buffer.data();
+  for (int f0 = block.start_frame; f0 < block.end_frame; f0 += flt_control_rate)
+  {
+    int f1 = std::min(f0 + flt_control_rate, block.end_frame);
+    std::array<float, Lines> gain_delta;
+    gains_at(f1 - 1, gain_delta.data());
+    for (int l = 0; l < Lines; l++)
+      gain_delta[l] = (gain_delta[l] - _fdn_gain[l]) / (f1 - f0);
+
+    for (int f = f0; f < f1; f++)
+    {
+      float damp = (1.0f - damp_curve[f]) * reverb_damp_scale;
+
+      std::array<float, Lines> x;
+      for (int l = 0; l < Lines; l++)
+      {
+        float val = buffer[((_fdn_pos - length[l]) & _fdn_mask) * Lines + l];
+        x[l] = length[l] <= _fdn_fill ? val : 0.0f;
+      }
+
+      float rev[2] = { 0.0f, 0.0f };
+      for (int l = 0; l < Lines; l += 2)
+      {
+        float sign = (l / 2) % 2 == 0 ? 1.0f : -1.0f;
+        rev[0] += sign * x[l];
+        rev[1] += sign * x[l + 1];
+      }
+
+      for (int l = 0; l < Lines; l++)
+      {
+        _fdn_gain[l] += gain_delta[l];
+        _fdn_filter[l] = (x[l] * (1.0f - damp)) + (_fdn_filter[l] * damp);
+        x[l] = _fdn_filter[l] * _fdn_gain[l];
+      }
+
+      for (int h = 1; h < Lines; h *= 2)
+        for (int i = 0; i < Lines; i += h * 2)
+          for (int j = i; j < i + h; j++)
+          {
+            float a = x[j];
+            float b = x[j + h];
+            x[j] = a + b;
+            x[j + h] = a - b;
+          }
+
+      float in_l = audio_in[0][f] * in_gain;
+      float in_r = audio_in[1][f] * in_gain;
+      float* row = buffer + _fdn_pos * Lines;
+      for (int l = 0; l < Lines; l += 2)
+      {
+        row[l] = x[l] + in_l;
+        row[l + 1] = x[l + 1] + in_r;
+      }
+      _fdn_pos = (_fdn_pos + 1) & _fdn_mask;
+      _fdn_fill += _fdn_fill <= _fdn_mask;
+
+      float wet = mix_curve[f] * reverb_wet_scale;
+      float dry = (1.0f - mix_curve[f]) * reverb_dry_scale;
+      float wet1 = wet * (spread_curve[f] / 2.0f + 0.5f);
+      float wet2 = wet * ((1.0f - spread_curve[f]) / 2.0f);
+      out[0][f] = rev[0] * wet1 + rev[1] * wet2 + audio_in[0][f] * dry;
+      out[1][f] = rev[1] * wet1 + rev[0] * wet2 + audio_in[1][f] * dry;
+    }
   }
 }
 
@@ -1538,15 +2190,15 @@ fx_engine::process_svf_uni(plugin_block& block,
   int svf_mode = block_auto[param_svf_mode][0].step();
   switch (svf_mode)
   {
-  case svf_mode_lpf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [this](double w, double res, double gn) { init_svf<svf_mode_lpf>(_svf, w, res, gn); }); break;
-  case svf_mode_hpf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [this](double w, double res, double gn) { init_svf<svf_mode_hpf>(_svf, w, res, gn); }); break;
-  case svf_mode_bpf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [this](double w, double res, double gn) { init_svf<svf_mode_bpf>(_svf, w, res, gn); }); break;
-  case svf_mode_bsf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [this](double w, double res, double gn) { init_svf<svf_mode_bsf>(_svf, w, res, gn); }); break;
-  case svf_mode_apf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [this](double w, double res, double gn) { init_svf<svf_mode_apf>(_svf, w, res, gn); }); break;
-  case svf_mode_peq: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [this](double w, double res, double gn) { init_svf<svf_mode_peq>(_svf, w, res, gn); }); break;
-  case svf_mode_bll: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [this](double w, double res, double gn) { init_svf<svf_mode_bll>(_svf, w, res, gn); }); break;
-  case svf_mode_lsh: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [this](double w, double res, double gn) { init_svf<svf_mode_lsh>(_svf, w, res, gn); }); break;
-  case svf_mode_hsh: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [this](double w, double res, double gn) { init_svf<svf_mode_hsh>(_svf, w, res, gn); }); break;
+  case svf_mode_lpf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [](auto& coeffs, double w, double res, double gn) { init_svf<svf_mode_lpf>(coeffs, w, res, gn); }); break;
+  case svf_mode_hpf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [](auto& coeffs, double w, double res, double gn) { init_svf<svf_mode_hpf>(coeffs, w, res, gn); }); break;
+  case svf_mode_bpf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [](auto& coeffs, double w, double res, double gn) { init_svf<svf_mode_bpf>(coeffs, w, res, gn); }); break;
+  case svf_mode_bsf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [](auto& coeffs, double w, double res, double gn) { init_svf<svf_mode_bsf>(coeffs, w, res, gn); }); break;
+  case svf_mode_apf: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [](auto& coeffs, double w, double res, double gn) { init_svf<svf_mode_apf>(coeffs, w, res, gn); }); break;
+  case svf_mode_peq: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [](auto& coeffs, double w, double res, double gn) { init_svf<svf_mode_peq>(coeffs, w, res, gn); }); break;
+  case svf_mode_bll: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [](auto& coeffs, double w, double res, double gn) { init_svf<svf_mode_bll>(coeffs, w, res, gn); }); break;
+  case svf_mode_lsh: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [](auto& coeffs, double w, double res, double gn) { init_svf<svf_mode_lsh>(coeffs, w, res, gn); }); break;
+  case svf_mode_hsh: process_svf_uni_mode<GlobalUnison>(block, audio_in, modulation, [](auto& coeffs, double w, double res, double gn) { init_svf<svf_mode_hsh>(coeffs, w, res, gn); }); break;
   default: assert(false); break;
   }
 }
@@ -1578,8 +2230,7 @@ fx_engine::process_svf_uni_mode(plugin_block& block,
   auto& gain_curve = block.state.own_scratch[scratch_flt_stvar_gain];
   block.normalized_to_raw_block<domain_type::linear>(this_module, param_svf_gain, gain_curve_norm, gain_curve);
 
-  for (int f = block.start_frame; f < block.end_frame; f++)
-  {
+  auto coeffs_at = [&](int f) {
     hz = freq_curve[f];
     kbd = kbd_curve[f];
     gain = gain_curve[f];
@@ -1595,10 +2246,22 @@ fx_engine::process_svf_uni_mode(plugin_block& block,
     hz *= std::pow(2.0, (kbd_trk - kbd_pivot) / 12.0 * kbd);
     hz = std::clamp(hz, flt_min_freq, flt_max_freq);
     w = pi64 * hz / block.sample_rate;
-    init(w, res_curve[f] * flt_max_res, gain);
-    for (int c = 0; c < 2; c++)
-      block.state.own_audio[0][0][c][f] = _svf.next(c, audio_in[c][f]);
-  }
+    state_var_filter_coeffs result = {};
+    init(result, w, res_curve[f] * flt_max_res, gain);
+    return result;
+  };
+
+  int s = block.start_frame;
+  int e = block.end_frame;
+  bool block_constant = freq_curve.is_constant(s, e) && res_curve.is_constant(s, e) && kbd_curve.is_constant(s, e) && gain_curve.is_constant(s, e);
+  if constexpr (GlobalUnison) block_constant &= glob_uni_dtn_curve->is_constant(s, e);
+
+  process_svf_control_rate(_svf, s, e, block_constant, coeffs_at, [&](int f) {
+    float lr[2] = { audio_in[0][f], audio_in[1][f] };
+    _svf.next(lr);
+    block.state.own_audio[0][0][0][f] = lr[0];
+    block.state.own_audio[0][0][1][f] = lr[1];
+  });
 }
 
 template <int N, int MeqFltMode>
@@ -1620,16 +2283,27 @@ void fx_engine::process_meq_single_filter(
   if constexpr (meq_has_gain(MeqFltMode))
     block.normalized_to_raw_block<domain_type::linear>(this_module, param_meq_gain, gain_curve_norm, gain_curve);
 
-  for (int f = block.start_frame; f < block.end_frame; f++)
-  {
+  auto coeffs_at = [&](int f) {
     double res = res_curve[f];
     double gain = gain_curve[f];
     double hz = std::clamp((double)freq_curve[f], flt_min_freq, flt_max_freq);
     double w = pi64 * hz / block.sample_rate;
-    init_svf<MeqFltMode - 1>(_meq_filters[N], w, res * flt_max_res, gain);
-    audio_out_l[f] = _meq_filters[N].next(0, audio_in_l[f]);
-    audio_out_r[f] = _meq_filters[N].next(1, audio_in_r[f]);
-  }
+    state_var_filter_coeffs result = {};
+    init_svf<MeqFltMode - 1>(result, w, res * flt_max_res, gain);
+    return result;
+  };
+
+  int s = block.start_frame;
+  int e = block.end_frame;
+  bool block_constant = freq_curve.is_constant(s, e) && res_curve.is_constant(s, e);
+  if constexpr (meq_has_gain(MeqFltMode)) block_constant &= gain_curve.is_constant(s, e);
+
+  process_svf_control_rate(_meq_filters[N], s, e, block_constant, coeffs_at, [&](int f) {
+    float lr[2] = { audio_in_l[f], audio_in_r[f] };
+    _meq_filters[N].next(lr);
+    audio_out_l[f] = lr[0];
+    audio_out_r[f] = lr[1];
+  });
 }
 
 void
@@ -1770,10 +2444,59 @@ fx_engine::process_meq(plugin_block& block,
     }
 }
 
+void
+fx_engine::background_dly()
+{
+  delete _dly_request.retired.exchange(nullptr);
+  int need = _dly_request.need.load();
+  if (need == dly_need_none)
+    delete _dly_request.ready.exchange(nullptr);
+  if (need != dly_need_lines || _dly_request.ready.load() != nullptr) return;
+  auto lines = std::make_unique<dly_lines>();
+  for (int c = 0; c < 2; c++)
+    lines->lines[c].init(_sample_rate * dly_max_sec);
+  _dly_request.ready.store(lines.release());
+}
+
+void
+fx_engine::alloc_dly_lines()
+{
+  _dly_current = new dly_lines;
+  for (int c = 0; c < 2; c++)
+    _dly_current->lines[c].init(_sample_rate * dly_max_sec);
+}
+
+// no worker means graph, not on the audio thread
+void
+fx_engine::update_dly_lines(int type)
+{
+  if (type == type_delay && !_dly_current)
+  {
+    if (_worker) _dly_current = _dly_request.ready.exchange(nullptr);
+    else alloc_dly_lines();
+  }
+  if (type != type_delay && _dly_current && _worker && _dly_request.retired.load() == nullptr)
+  {
+    _dly_request.retired.store(_dly_current);
+    post_job();
+    _dly_current = nullptr;
+  }
+  if (!_worker) return;
+  int need = type != type_delay ? dly_need_none : _dly_current ? dly_need_have : dly_need_lines;
+  if (_dly_request.need.exchange(need) != need) post_job();
+}
+
 void
 fx_engine::process_delay(plugin_block& block, 
   jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation)
 {
+  if (!_dly_current)
+  {
+    for (int c = 0; c < 2; c++)
+      audio_in[c].copy_to(block.start_frame, block.end_frame, block.state.own_audio[0][0][c]);
+    return;
+  }
+
   auto const& block_auto = block.state.own_block_automation;
   bool sync = block_auto[param_dly_sync][0].step() != 0;
   if(sync) process_delay_sync<true>(block, audio_in, modulation);
@@ -1797,6 +2520,7 @@ void fx_engine::process_dly_fdbk_sync(plugin_block& block,
   jarray<float, 2> const& audio_in, cv_audio_matrix_mixdown const& modulation)
 {
   float const max_feedback = 0.99f;
+  auto& lines = _dly_current->lines;
   auto const& block_auto = block.state.own_block_automation;
 
   auto& l_time_curve = block.state.own_scratch[scratch_dly_fdbk_l];
@@ -1823,33 +2547,18 @@ void fx_engine::process_dly_fdbk_sync(plugin_block& block,
 
   for (int f = block.start_frame; f < block.end_frame; f++)
   {
-    float l_time_samples_t = l_time_curve[f] * block.sample_rate;
-    float r_time_samples_t = r_time_curve[f] * block.sample_rate;
-    float l_time_t = l_time_samples_t - (int)l_time_samples_t;
-    float r_time_t = r_time_samples_t - (int)r_time_samples_t;
-    int l_time_samples_0 = (int)l_time_samples_t;
-    int l_time_samples_1 = (int)l_time_samples_t + 1;
-    int r_time_samples_0 = (int)r_time_samples_t;
-    int r_time_samples_1 = (int)r_time_samples_t + 1;
-
-    // double mod is needed to not go negative
     float dry_l = audio_in[0][f];
     float dry_r = audio_in[1][f];
-    float wet_l0 = _dly_buffer[0][(((_dly_pos - l_time_samples_0) % _dly_capacity) + _dly_capacity) % _dly_capacity];
-    float wet_l1 = _dly_buffer[0][(((_dly_pos - l_time_samples_1) % _dly_capacity) + _dly_capacity) % _dly_capacity];
-    float wet_l_base = ((1 - l_time_t) * wet_l0 + l_time_t * wet_l1) * amt_curve[f] * max_feedback;
-    float wet_r0 = _dly_buffer[1][(((_dly_pos - r_time_samples_0) % _dly_capacity) + _dly_capacity) % _dly_capacity];
-    float wet_r1 = _dly_buffer[1][(((_dly_pos - r_time_samples_1) % _dly_capacity) + _dly_capacity) % _dly_capacity];
-    float wet_r_base = ((1 - r_time_t) * wet_r0 + r_time_t * wet_r1) * amt_curve[f] * max_feedback;
-    _dly_buffer[0][_dly_pos] = dry_l + wet_l_base;
-    _dly_buffer[1][_dly_pos] = dry_r + wet_r_base;
+    float wet_l_base = lines[0].read_linear(l_time_curve[f] * block.sample_rate) * amt_curve[f] * max_feedback;
+    float wet_r_base = lines[1].read_linear(r_time_curve[f] * block.sample_rate) * amt_curve[f] * max_feedback;
+    lines[0].write(dry_l + wet_l_base);
+    lines[1].write(dry_r + wet_r_base);
 
     // note: treat spread as unipolar for feedback
     float wet_l = wet_l_base + (1.0f - spread_curve[f]) * wet_r_base;
     float wet_r = wet_r_base + (1.0f - spread_curve[f]) * wet_l_base;
     block.state.own_audio[0][0][0][f] = (1.0f - mix_curve[f]) * dry_l + mix_curve[f] * wet_l;
     block.state.own_audio[0][0][1][f] = (1.0f - mix_curve[f]) * dry_r + mix_curve[f] * wet_r;
-    _dly_pos = (_dly_pos + 1) % _dly_capacity;
   }
 }
 
@@ -1884,35 +2593,84 @@ void fx_engine::process_dly_multi_sync(plugin_block& block,
     std::fill(time_curve.begin() + block.start_frame, time_curve.begin() + block.end_frame, time);
   }
 
-  for (int f = block.start_frame; f < block.end_frame; f++)
-  {
+  // taps as soa, delay is shared, gain is per channel
+  // tap gain goes 1 - (1 - amt)^2, then squared for each next tap
+  float tap_delay[dly_max_taps];
+  float tap_gain[2][dly_max_taps];
+  auto init_taps = [&](int f) {
     float spread = spread_curve[f];
     float time_samples_t = time_curve[f] * block.sample_rate;
     float hold_samples_t = hold_curve[f] * block.sample_rate;
+    float tap_amt = 1.0f - (1.0f - amt_curve[f]) * (1.0f - amt_curve[f]);
+    for (int t = 0; t < tap_count; t++)
+    {
+      tap_delay[t] = (t + 1) * time_samples_t + hold_samples_t;
+      for (int c = 0; c < 2; c++)
+        tap_gain[c][t] = stereo_balance2((t + c) % 2, spread) * tap_amt;
+      tap_amt *= tap_amt;
+    }
+  };
+
+  // when the taps hold for the block and all of them reach back beyond
+  // it (but not beyond the line), the whole block can be read in one go for each tap
+  int s = block.start_frame;
+  int e = block.end_frame;
+  if (time_curve.is_constant(s, e) && hold_curve.is_constant(s, e) && 
+    amt_curve.is_constant(s, e) && spread_curve.is_constant(s, e))
+  {
+    init_taps(s);
+    int capacity = _dly_current->lines[0].capacity();
+    if ((int)tap_delay[0] >= e - s && (int)tap_delay[tap_count - 1] + 1 <= capacity)
+    {
+      process_dly_multi_block(block, audio_in, mix_curve, tap_count, tap_delay, &tap_gain[0][0]);
+      return;
+    }
+  }
 
+  auto& lines = _dly_current->lines;
+  for (int f = s; f < e; f++)
+  {
+    init_taps(f);
     for (int c = 0; c < 2; c++)
     {
       float wet = 0.0f;
-      float tap_amt = 1.0f - (1.0f - amt_curve[f]) * (1.0f - amt_curve[f]);
       for (int t = 0; t < tap_count; t++)
-      {
-        int lr = (t + c) % 2;
-        float tap_bal = stereo_balance2(lr, spread);
-        float tap_samples_t = (t + 1) * time_samples_t + hold_samples_t;
-        float tap_t = tap_samples_t - (int)tap_samples_t;
-        int tap_samples_0 = (int)tap_samples_t % _dly_capacity;
-        int tap_samples_1 = ((int)tap_samples_t + 1) % _dly_capacity;
-        float buffer_sample_0 = _dly_buffer[c][(_dly_pos + 2 * _dly_capacity - tap_samples_0) % _dly_capacity];
-        float buffer_sample_1 = _dly_buffer[c][(_dly_pos + 2 * _dly_capacity - tap_samples_1) % _dly_capacity];
-        float buffer_sample = ((1 - tap_t) * buffer_sample_0 + tap_t * buffer_sample_1);
-        wet += tap_bal * tap_amt * buffer_sample;
-        tap_amt *= tap_amt;
-      }
+        wet += tap_gain[c][t] * lines[c].read_linear(tap_delay[t]);
       float dry = audio_in[c][f];
-      _dly_buffer[c][_dly_pos] = dry;
+      lines[c].write(dry);
       block.state.own_audio[0][0][c][f] = (1.0f - mix_curve[f]) * dry + (mix_curve[f] * wet);
     }
-    _dly_pos = (_dly_pos + 1) % _dly_capacity;
+  }
+}
+
+// tap_gain is [2][dly_max_taps]
+// read both interpolation points for the entire block, then lerp in a separate pass
+void
+fx_engine::process_dly_multi_block(plugin_block& block, jarray<float, 2> const& audio_in,
+  jarray<float, 1> const& mix_curve, int tap_count, float const* tap_delay, float const* tap_gain)
+{
+  int s = block.start_frame;
+  int e = block.end_frame;
+  auto& lo = block.state.own_scratch[scratch_dly_multi_lo];
+  auto& hi = block.state.own_scratch[scratch_dly_multi_hi];
+  for (int c = 0; c < 2; c++)
+  {
+    auto& line = _dly_current->lines[c];
+    auto& wet = block.state.own_scratch[scratch_dly_multi_wet_l + c];
+    wet.fill(s, e, 0.0f);
+    for (int t = 0; t < tap_count; t++)
+    {
+      int whole = (int)tap_delay[t];
+      float frac = tap_delay[t] - whole;
+      float gain = tap_gain[c * dly_max_taps + t];
+      line.read_block(whole, lo.data().data() + s, e - s);
+      line.read_block(whole + 1, hi.data().data() + s, e - s);
+      for (int f = s; f < e; f++)
+        wet[f] += gain * ((1.0f - frac) * lo[f] + frac * hi[f]);
+    }
+    line.write_block(audio_in[c].data().data() + s, e - s);
+    for (int f = s; f < e; f++)
+      block.state.own_audio[0][0][c][f] = (1.0f - mix_curve[f]) * audio_in[c][f] + (mix_curve[f] * wet[f]);
   }
 }
 
@@ -1920,11 +2678,15 @@ void
 fx_engine::dist_svf_next(plugin_block const& block, int oversmp_factor,
   double freq_hz, double res, float& left, float& right)
 {
+  // modulation is not oversampled, and often constant
+  // so coefficients are only updated when they change
   double const max_res = 0.99;
   double w = pi64 * freq_hz / (block.sample_rate * oversmp_factor);
-  _dst_svf.init_lpf(w, res * max_res);
-  left = _dst_svf.next(0, left);
-  right = _dst_svf.next(1, right);
+  _dst_svf.init(w, res * max_res, [](auto& coeffs, double w, double res) { coeffs.init_lpf(w, res); });
+  float lr[2] = { left, right };
+  _dst_svf.next(lr);
+  left = lr[0];
+  right = lr[1];
 }
 
 template <bool Graph> void
@@ -2082,40 +2844,22 @@ fx_engine::process_dist_mode_xy_clip(plugin_block& block,
     return;
   }
 
-  switch (block_auto[param_dist_shaper][0].step())
+  // trig shapers go through the shared lookup tables
+  int shape = block_auto[param_dist_shaper][0].step();
+  if (wave_shape_has_bi_lut(shape))
+  {
+    auto const& lut = wave_shape_bi_lut_for(shape);
+    process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
+      block, audio_in, modulation, skew_x, skew_y, clip, [&lut](float in, float dsf_parts, float dsf_dcy) { return lut(in); });
+    return;
+  }
+
+  switch (shape)
   {
   case wave_shape_type_saw: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
     block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_saw); break;
   case wave_shape_type_tri: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
     block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_tri); break;
-  case wave_shape_type_sin: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_sin); break;
-  case wave_shape_type_cos: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_cos); break;
-  case wave_shape_type_sin_sin: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_sin_sin); break;
-  case wave_shape_type_sin_cos: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_sin_cos); break;
-  case wave_shape_type_cos_sin: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_cos_sin); break;
-  case wave_shape_type_cos_cos: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_cos_cos); break;
-  case wave_shape_type_sin_sin_sin: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_sin_sin_sin); break;
-  case wave_shape_type_sin_sin_cos: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_sin_sin_cos); break;
-  case wave_shape_type_sin_cos_sin: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_sin_cos_sin); break;
-  case wave_shape_type_sin_cos_cos: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_sin_cos_cos); break;
-  case wave_shape_type_cos_sin_sin: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_cos_sin_sin); break;
-  case wave_shape_type_cos_sin_cos: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_cos_sin_cos); break;
-  case wave_shape_type_cos_cos_sin: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_cos_cos_sin); break;
-  case wave_shape_type_cos_cos_cos: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
-    block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_cos_cos_cos); break;
   case wave_shape_type_sqr_or_fold: process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
     block, audio_in, modulation, skew_x, skew_y, clip, wave_shape_bi_fold); break;
   default: assert(false); break;
@@ -2135,11 +2879,13 @@ fx_engine::process_dist_mode_xy_clip_clamp(plugin_block& block,
   float oversmp_rate = block.sample_rate * oversmp_factor;
   process_dist_mode_xy_clip_shape<Graph, Mode, SkewX, SkewY, ClipIsExp, Clip>(
     block, audio_in, modulation, skew_x, skew_y, clip,
-    [dsf_dist, dsf_freq, oversmp_rate, clamp](float in, float dsf_parts, float dsf_dcy) {
+    [this, dsf_dist, dsf_freq, oversmp_rate, clamp](float in, float dsf_parts, float dsf_dcy) {
       // input may exceed -1/+1, need to get into 0..1 to use as a phase
       // note: the pre-clip (clamper) is never "exp", so 2nd arg dont matter
+      // phase is signal driven so no recurrence, but this skips the pow while parts/decay hold
       float phase = bipolar_to_unipolar(clamp(in, 0.0f));
-      return generate_dsf<float>(phase, oversmp_rate, dsf_freq, dsf_parts, dsf_dist, dsf_dcy);
+      _dst_dsf.init(oversmp_rate, dsf_freq, dsf_parts, (float)dsf_dist, dsf_dcy);
+      return _dst_dsf.eval(phase);
     });
 }
 
@@ -2160,12 +2906,17 @@ fx_engine::process_dist_mode_xy_clip_shape(plugin_block& block,
   auto const& x_curve_plain = *modulation[this_module][block.module_slot][param_dist_skew_x_amt][0];
   auto const& y_curve_plain = *modulation[this_module][block.module_slot][param_dist_skew_y_amt][0];
 
+  // skew amounts and gain are mostly not modulated, then the
+  // exp/log conversions only need to happen once for the block
+  int s = block.start_frame;
+  int e = block.end_frame;
+  auto exp_skew_amt = [](float amt) { return (float)(std::log(0.001 + (amt * 0.98)) / log_half); };
   jarray<float, 1> const* x_curve = &x_curve_plain;
   if(wave_skew_is_exp(skew_x_type))
   {
     auto& x_scratch = block.state.own_scratch[scratch_dist_x];
-    for (int f = block.start_frame; f < block.end_frame; f++)
-      x_scratch[f] = std::log(0.001 + (x_curve_plain[f] * 0.98)) / log_half;
+    if (x_curve_plain.is_constant(s, e)) x_scratch.fill(s, e, exp_skew_amt(x_curve_plain[s]));
+    else x_curve_plain.transform_to(s, e, x_scratch, exp_skew_amt);
     x_curve = &x_scratch;
   }
 
@@ -2173,14 +2924,17 @@ fx_engine::process_dist_mode_xy_clip_shape(plugin_block& block,
   if (wave_skew_is_exp(skew_y_type))
   {
     auto& y_scratch = block.state.own_scratch[scratch_dist_y];
-    for (int f = block.start_frame; f < block.end_frame; f++)
-      y_scratch[f] = std::log(0.001 + (y_curve_plain[f] * 0.98)) / log_half;
+    if (y_curve_plain.is_constant(s, e)) y_scratch.fill(s, e, exp_skew_amt(y_curve_plain[s]));
+    else y_curve_plain.transform_to(s, e, y_scratch, exp_skew_amt);
     y_curve = &y_scratch;
   }
 
   auto& gain_curve = block.state.own_scratch[scratch_dist_gain_raw];
   auto const& gain_curve_plain = *modulation[this_module][block.module_slot][param_dist_gain][0];
-  block.normalized_to_raw_block<domain_type::log>(this_module, param_dist_gain, gain_curve_plain, gain_curve);
+  if (!gain_curve_plain.is_constant(s, e))
+    block.normalized_to_raw_block<domain_type::log>(this_module, param_dist_gain, gain_curve_plain, gain_curve);
+  else
+    gain_curve.fill(s, e, block.normalized_to_raw_fast<domain_type::log>(this_module, param_dist_gain, gain_curve_plain[s]));
 
   auto& lp_freq_curve = block.state.own_scratch[scratch_dist_svf_freq];
   auto const& lp_freq_curve_plain = *modulation[this_module][block.module_slot][param_dist_lp_frq][0];
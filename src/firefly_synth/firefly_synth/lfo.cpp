@@ -136,6 +136,12 @@ public module_engine {
   int _end_filter_pos = 0;
   int _end_filter_stage_samples = 0;
 
+  // control rate, ramp towards the next computed value
+  int _ctrl_frames_left = 0;
+  bool _ctrl_primed = false;
+  float _ctrl_delta = 0;
+  float _ctrl_target = 0;
+
   int _per_voice_seed = -1;
   int _prev_global_seed = -1;
   int _prev_global_type = -1;
@@ -268,7 +274,8 @@ render_graph(
 
   auto const* block = engine->process(mapping.module_index, mapping.module_slot, custom_outputs, nullptr, [&](plugin_block& block) {
     lfo_engine engine(global);
-    cv_cv_matrix_mixdown modulation(make_static_cv_matrix_mixdown(block)[mapping.module_index][mapping.module_slot]);
+    cv_matrix_mixdown mixdown(make_static_cv_matrix_mixdown(block));
+    cv_cv_matrix_mixdown modulation(mixdown[mapping.module_index][mapping.module_slot]);
     engine.reset_graph(&block, nullptr, nullptr, custom_outputs, &modulation);
     engine.process_graph(block, nullptr, nullptr, custom_outputs, &modulation);
   });
@@ -799,6 +806,10 @@ lfo_engine::reset_audio(
   _lfo_end_value = 0;
   _end_filter_pos = 0;
   _filter_end_value = 0;
+  _ctrl_delta = 0;
+  _ctrl_target = 0;
+  _ctrl_primed = false;
+  _ctrl_frames_left = 0;
   _stage = lfo_stage::cycle;
   _end_filter_stage_samples = 0;
   _per_voice_seed = -1;
@@ -999,26 +1010,22 @@ lfo_engine::process_uni_type_sync_snap(plugin_block& block, cv_cv_matrix_mixdown
     return;
   }
 
+  // sin/cos family goes through the shared distortion tables, uni(x) is bi(2x)
   int seed = _global ? _prev_global_seed : _per_voice_seed;
-  switch (block_auto[param_shape][0].step())
+  int shape = block_auto[param_shape][0].step();
+  if (wave_shape_has_bi_lut(shape))
+  {
+    auto const& lut = wave_shape_bi_lut_for(shape);
+    process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, [&lut](float in) {
+      return std::clamp(bipolar_to_unipolar(lut(2.0f * in)), 0.0f, 1.0f); });
+    return;
+  }
+
+  switch (shape)
   {
   case wave_shape_type_saw: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_saw); break;
   case wave_shape_type_tri: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_tri); break;
-  case wave_shape_type_sin: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_sin); break;
-  case wave_shape_type_cos: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_cos); break;
   case wave_shape_type_sqr_or_fold: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_sqr); break;
-  case wave_shape_type_sin_sin: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_sin_sin); break;
-  case wave_shape_type_sin_cos: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_sin_cos); break;
-  case wave_shape_type_cos_sin: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_cos_sin); break;
-  case wave_shape_type_cos_cos: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_cos_cos); break;
-  case wave_shape_type_sin_sin_sin: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_sin_sin_sin); break;
-  case wave_shape_type_sin_sin_cos: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_sin_sin_cos); break;
-  case wave_shape_type_sin_cos_sin: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_sin_cos_sin); break;
-  case wave_shape_type_sin_cos_cos: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_sin_cos_cos); break;
-  case wave_shape_type_cos_sin_sin: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_cos_sin_sin); break;
-  case wave_shape_type_cos_sin_cos: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_cos_sin_cos); break;
-  case wave_shape_type_cos_cos_sin: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_cos_cos_sin); break;
-  case wave_shape_type_cos_cos_cos: process_uni_type_sync_snap_shape<GlobalUnison, Type, Sync, Snap, false>(block, modulation, wave_shape_uni_cos_cos_cos); break;
   case wave_shape_type_smooth_1:
   case wave_shape_type_smooth_2:
   case wave_shape_type_smooth_free_1:
@@ -1108,7 +1115,21 @@ lfo_engine::process_uni_type_sync_snap_shape_xy_quantize(plugin_block& block, cv
   bool x_is_exp = wave_skew_is_exp(sx);
   bool y_is_exp = wave_skew_is_exp(sy);
 
-  if (!x_is_exp && !y_is_exp)
+  // skew amounts are usually not modulated per-sample, 
+  // in that case derive the exponents once per block
+  auto const& x_curve = *(*modulation)[param_skew_x_amt][0];
+  auto const& y_curve = *(*modulation)[param_skew_y_amt][0];
+  if (x_curve.is_constant(block.start_frame, block.end_frame) && y_curve.is_constant(block.start_frame, block.end_frame))
+  {
+    float px = x_curve[block.start_frame];
+    float py = y_curve[block.start_frame];
+    if (x_is_exp) px = std::log(0.001 + (px * 0.999)) / log_half;
+    if (y_is_exp) py = std::log(0.001 + (py * 0.999)) / log_half;
+    auto processor = [skew_x, skew_y, shape, px, py](float in, float, float) {
+      return wave_calc_uni(in, px, py, shape, skew_x, skew_y); };
+    process_loop<GlobalUnison, Type, Sync, Snap>(block, modulation, processor, quantize);
+  }
+  else if (!x_is_exp && !y_is_exp)
   {
     auto processor = [skew_x, skew_y, shape](float in, float x, float y) { 
       return wave_calc_uni(in, x, y, shape, skew_x, skew_y); };
@@ -1150,6 +1171,12 @@ void lfo_engine::process_loop(plugin_block& block, cv_cv_matrix_mixdown const* m
   auto const& y_curve = *(*modulation)[param_skew_y_amt][0];
   auto& rate_curve = block.state.own_scratch[scratch_rate];
 
+  // only compute every n frames if all routes reading from us are control rate
+  // this lags by one step, phase still advances per frame so timing is not affected
+  int decimation = 1;
+  if (!block.graph)
+    decimation = get_cv_cv_matrix_mixer(block, _global).source_decimation(block, this_module, block.module_slot);
+
   if constexpr (Sync)
   {
     timesig sig = get_timesig_param_value(block, this_module, param_tempo);
@@ -1219,8 +1246,16 @@ void lfo_engine::process_loop(plugin_block& block, cv_cv_matrix_mixdown const* m
       continue;
     }
 
-    _lfo_end_value = quantize(calc(_phase, x_curve[f], y_curve[f]), steps);
-    _filter_end_value = _filter.next(check_unipolar(_lfo_end_value));
+    if (_ctrl_frames_left == 0)
+    {
+      _ctrl_target = check_unipolar(quantize(calc(_phase, x_curve[f], y_curve[f]), steps));
+      if (!_ctrl_primed) _lfo_end_value = _ctrl_target;
+      _ctrl_primed = true;
+      _ctrl_frames_left = decimation;
+      _ctrl_delta = (_ctrl_target - _lfo_end_value) / decimation;
+    }
+    _lfo_end_value = --_ctrl_frames_left == 0 ? _ctrl_target : _lfo_end_value + _ctrl_delta;
+    _filter_end_value = _filter.next(_lfo_end_value);
     block.state.own_cv[0][0][f] = _filter_end_value;
 
     bool phase_wrapped = increment_and_wrap_phase(_phase, rate_curve[f], block.sample_rate);
@@ -9,6 +9,7 @@
 #include <firefly_synth/synth.hpp>
 
 #include <cmath>
+#include <array>
 #include <algorithm>
 
 using namespace plugin_base;
@@ -22,6 +23,23 @@ enum { scratch_bal, scratch_count };
 enum { output_silence, output_mixed };
 enum { param_on, param_source, param_target, param_gain, param_bal };
 
+// active route in the compiled routing plan
+struct audio_plan_route
+{
+  int route;
+  int source_module;
+  int source_slot;
+};
+
+// routes [route_start, route_end) mix into module/slot
+struct audio_plan_target
+{
+  int module;
+  int slot;
+  int route_start;
+  int route_end;
+};
+
 // mixes down into a single audio target on demand
 class audio_audio_matrix_engine:
 public module_engine { 
@@ -31,6 +49,18 @@ public module_engine {
   std::vector<module_topo_mapping> const _sources;
   std::vector<module_topo_mapping> const _targets;
 
+  // routing compiled to route lists per target, rebuilt only when
+  // on/source/target of any route changes, so mix() only runs its own list
+  bool _plan_valid = false;
+  int _plan_route_count = 0;
+  int _plan_target_count = 0;
+  std::array<int, route_count * 3> _plan_key = {};
+  std::array<audio_plan_route, route_count> _plan_routes = {};
+  std::array<audio_plan_target, route_count> _plan_targets = {};
+
+  void update_plan(plugin_block const& block);
+  void compile_plan();
+
 public:
   PB_PREVENT_ACCIDENTAL_COPY(audio_audio_matrix_engine);
   audio_audio_matrix_engine(bool global,
@@ -40,13 +70,50 @@ public:
 
   void reset_audio(plugin_block const*,
     std::vector<note_event> const* in_notes,
-    std::vector<note_event>* out_notes) override {}
+    std::vector<note_event>* out_notes) override { _plan_valid = false; }
   void process_audio(plugin_block& block,
     std::vector<note_event> const* in_notes,
     std::vector<note_event>* out_notes) override;
   jarray<float, 2> const& mix(plugin_block& block, int module, int slot);
 };
 
+// out = in * gain for the first route on a target, out += in * gain after that
+template <bool First> static void
+audio_route_mix(float const* in, float* out, int start_frame, int end_frame, float gain)
+{
+  if (gain == 1.0f)
+    for (int f = start_frame; f < end_frame; f++)
+      if constexpr (First) out[f] = in[f];
+      else out[f] += in[f];
+  else
+    for (int f = start_frame; f < end_frame; f++)
+      if constexpr (First) out[f] = in[f] * gain;
+      else out[f] += in[f] * gain;
+}
+
+// same with modulated gain/balance, both channels in one pass
+template <bool First> static void
+audio_route_mix_curve(
+  float const* in_l, float const* in_r, float* out_l, float* out_r,
+  float const* gain, float const* bal, int start_frame, int end_frame)
+{
+  for (int f = start_frame; f < end_frame; f++)
+  {
+    float l = in_l[f] * gain[f] * stereo_balance<0>(bal[f]);
+    float r = in_r[f] * gain[f] * stereo_balance<1>(bal[f]);
+    if constexpr (First)
+    {
+      out_l[f] = l;
+      out_r[f] = r;
+    }
+    else
+    {
+      out_l[f] += l;
+      out_r[f] += r;
+    }
+  }
+}
+
 static void
 init_voice_minimal(plugin_state& state)
 {
@@ -266,56 +333,129 @@ audio_audio_matrix_engine::process_audio(
   // mixing "own" does not refer to us but to the caller
   *block.state.own_context = &_mixer; 
   _own_audio = &block.state.own_audio; 
+  update_plan(block);
 }
 
-jarray<float, 2> const& 
-audio_audio_matrix_engine::mix(plugin_block& block, int module, int slot)
+void
+audio_audio_matrix_engine::update_plan(plugin_block const& block)
 {
-  // audio 0 is silence
-  bool activated = false;
-  jarray<float, 2>* result = &(*_own_audio)[output_silence][0];
+  bool changed = !_plan_valid;
+  auto const& block_auto = block.state.own_block_automation;
+  for (int r = 0; r < route_count; r++)
+    for (int p = 0; p < 3; p++)
+    {
+      // param_on, param_source, param_target
+      int value = block_auto[param_on + p][r].step();
+      changed |= _plan_key[r * 3 + p] != value;
+      _plan_key[r * 3 + p] = value;
+    }
+  if (changed) compile_plan();
+}
 
-  // loop through the routes
-  // the first match we encounter becomes the mix target
-  int this_module = _global? module_gaudio_audio_matrix: module_vaudio_audio_matrix;
-  auto const& block_auto = block.state.all_block_automation[this_module][0];
+void
+audio_audio_matrix_engine::compile_plan()
+{
+  _plan_valid = true;
+  _plan_route_count = 0;
+  _plan_target_count = 0;
   for (int r = 0; r < route_count; r++)
   {
-    if(block_auto[param_on][r].step() == 0) continue;
-    int selected_target = block_auto[param_target][r].step();
-    int tm = _targets[selected_target].index;
-    int tmi = _targets[selected_target].slot;
-    if(tm != module || tmi != slot) continue;
+    if (_plan_key[r * 3 + param_on] == 0) continue;
+    int selected_target = _plan_key[r * 3 + param_target];
+    bool found = false;
+    for (int t = 0; t < _plan_target_count && !found; t++)
+      found = _plan_targets[t].module == _targets[selected_target].index && 
+        _plan_targets[t].slot == _targets[selected_target].slot;
+    if (found) continue;
+    auto& target = _plan_targets[_plan_target_count++];
+    target.module = _targets[selected_target].index;
+    target.slot = _targets[selected_target].slot;
+  }
 
-    if (!activated)
+  // routes per target, in route order
+  for (int t = 0; t < _plan_target_count; t++)
+  {
+    auto& target = _plan_targets[t];
+    target.route_start = _plan_route_count;
+    for (int r = 0; r < route_count; r++)
     {
-      result = &(*_own_audio)[output_mixed][r];
-      (*result)[0].fill(block.start_frame, block.end_frame, 0.0f);
-      (*result)[1].fill(block.start_frame, block.end_frame, 0.0f);
-      activated = true;
+      if (_plan_key[r * 3 + param_on] == 0) continue;
+      auto const& selected_target = _targets[_plan_key[r * 3 + param_target]];
+      if (selected_target.index != target.module || selected_target.slot != target.slot) continue;
+      auto const& selected_source = _sources[_plan_key[r * 3 + param_source]];
+      auto& route = _plan_routes[_plan_route_count++];
+      route.route = r;
+      route.source_module = selected_source.index;
+      route.source_slot = selected_source.slot;
     }
+    target.route_end = _plan_route_count;
+  }
+}
+
+jarray<float, 2> const& 
+audio_audio_matrix_engine::mix(plugin_block& block, int module, int slot)
+{
+  // audio 0 is silence
+  int t = 0;
+  while (t < _plan_target_count && (_plan_targets[t].module != module || _plan_targets[t].slot != slot)) t++;
+  if (t == _plan_target_count) return (*_own_audio)[output_silence][0];
 
-    // find out audio source to add
-    auto& mix = *result;
-    int selected_source = block_auto[param_source][r].step();
-    int sm = _sources[selected_source].index;
-    int smi = _sources[selected_source].slot;
+  int this_module = _global ? module_gaudio_audio_matrix : module_vaudio_audio_matrix;
+  auto const& target = _plan_targets[t];
+  auto const& modulation = get_cv_audio_matrix_mixdown(block, _global);
+
+  // single source at unit gain and center balance is just the source
+  if (target.route_end - target.route_start == 1)
+  {
+    auto const& route = _plan_routes[target.route_start];
+    auto const& gain_curve = *modulation[this_module][0][param_gain][route.route];
+    auto const& bal_curve_norm = *modulation[this_module][0][param_bal][route.route];
+    if (gain_curve.is_constant(block.start_frame, block.end_frame) && gain_curve[block.start_frame] == 1.0f &&
+      bal_curve_norm.is_constant(block.start_frame, block.end_frame) &&
+      block.normalized_to_raw_fast<domain_type::linear>(this_module, param_bal, bal_curve_norm[block.start_frame]) == 0.0f)
+      return block.module_audio(route.source_module, route.source_slot)[0][0];
+  }
+
+  // first route in the list writes, the others add
+  auto& mix = (*_own_audio)[output_mixed][_plan_routes[target.route_start].route];
+  for (int pr = target.route_start; pr < target.route_end; pr++)
+  {
+    bool first = pr == target.route_start;
+    auto const& route = _plan_routes[pr];
+    auto const& source_audio = block.module_audio(route.source_module, route.source_slot)[0][0];
+    auto const& gain_curve = *modulation[this_module][0][param_gain][route.route];
+    auto const& bal_curve_norm = *modulation[this_module][0][param_bal][route.route];
 
     // add modulated amount to mixdown
-    auto const& source_audio = block.module_audio(sm, smi);
-    auto const& modulation = get_cv_audio_matrix_mixdown(block, _global);
-    auto const& gain_curve = *modulation[this_module][0][param_gain][r];
-    auto const& bal_curve_norm = *modulation[this_module][0][param_bal][r];
-    auto& bal_curve = block.state.own_scratch[scratch_bal];
-    block.normalized_to_raw_block<domain_type::linear>(this_module, param_bal, bal_curve_norm, bal_curve);
-    for (int f = block.start_frame; f < block.end_frame; f++)
+    if (gain_curve.is_constant(block.start_frame, block.end_frame) && 
+      bal_curve_norm.is_constant(block.start_frame, block.end_frame))
     {
-      mix[0][f] += gain_curve[f] * stereo_balance<0>(bal_curve[f]) * source_audio[0][0][0][f];
-      mix[1][f] += gain_curve[f] * stereo_balance<1>(bal_curve[f]) * source_audio[0][0][1][f];
+      float gain = gain_curve[block.start_frame];
+      float bal = block.normalized_to_raw_fast<domain_type::linear>(this_module, param_bal, bal_curve_norm[block.start_frame]);
+      for (int c = 0; c < 2; c++)
+      {
+        float channel_gain = gain * (c == 0 ? stereo_balance<0>(bal) : stereo_balance<1>(bal));
+        float const* in = source_audio[c].data().data();
+        float* out = mix[c].data().data();
+        if (first) audio_route_mix<true>(in, out, block.start_frame, block.end_frame, channel_gain);
+        else audio_route_mix<false>(in, out, block.start_frame, block.end_frame, channel_gain);
+      }
+      continue;
     }
+
+    auto& bal_curve = block.state.own_scratch[scratch_bal];
+    block.normalized_to_raw_block<domain_type::linear>(this_module, param_bal, bal_curve_norm, bal_curve);
+    float const* in_l = source_audio[0].data().data();
+    float const* in_r = source_audio[1].data().data();
+    float* out_l = mix[0].data().data();
+    float* out_r = mix[1].data().data();
+    float const* gain = gain_curve.data().data();
+    float const* bal = bal_curve.data().data();
+    if (first) audio_route_mix_curve<true>(in_l, in_r, out_l, out_r, gain, bal, block.start_frame, block.end_frame);
+    else audio_route_mix_curve<false>(in_l, in_r, out_l, out_r, gain, bal, block.start_frame, block.end_frame);
   }
 
-  return *result;
+  return mix;
 }
 
 }
@@ -1,4 +1,3 @@
-#include <plugin_base/desc/dims.hpp>
 #include <plugin_base/dsp/engine.hpp>
 #include <plugin_base/dsp/utility.hpp>
 #include <plugin_base/topo/plugin.hpp>
@@ -10,6 +9,7 @@
 #include <firefly_synth/synth.hpp>
 
 #include <cmath>
+#include <array>
 #include <algorithm>
 
 using namespace plugin_base; 
@@ -27,20 +27,141 @@ static int constexpr max_audio_route_count = std::max(vaudio_route_count, gaudio
 static int constexpr max_any_route_count = std::max(max_cv_route_count, max_audio_route_count);
 
 enum { section_main };
-enum { scratch_transform_source, scratch_offset, scratch_scale, scratch_count };
-enum { param_type, param_source, param_target, param_offset, param_scale, param_min, param_max };
+enum { scratch_offset, scratch_scale, scratch_count };
+enum { param_type, param_source, param_target, param_offset, param_scale, param_min, param_max, param_rate };
+enum { rate_audio, rate_8, rate_16, rate_32 };
+enum { plan_key_type, plan_key_source, plan_key_target, plan_key_rate, plan_key_count };
 enum { type_off, type_mul_abs, type_mul_rel, type_mul_stk, type_add_abs, type_add_rel, type_add_stk, type_ab_abs, type_ab_rel, type_ab_stk };
 
-// for every param that gets modulated by the cv matrix,
-// we output the final value per block as parameter modulation output
-struct mod_output_usage
+// active route in the compiled routing plan
+struct cv_plan_route
 {
-  bool in_use;
+  int route;
+  int type;
+  jarray<float, 1> const* source;
+};
+
+// single route, curves are indexed by frame or broadcast from [0] if Const
+// step > 1 is control rate, only every step'th frame is computed
+struct cv_route_args
+{
+  int step;
+  int start_frame;
+  int end_frame;
+  float const* source;
+  float const* target;
+  float const* scale;
+  float const* offset;
+  float const* min;
+  float const* max;
+  float* modulated;
+};
+
+// modulated param in the compiled routing plan, we output the final value 
+// per block as parameter modulation output, routes [route_start, route_end) apply
+// decimation is the lowest rate of all routes, so any audio rate route makes it 1
+struct cv_plan_target
+{
+  int target;
+  int decimation;
+  int module_index;
+  int module_slot;
   int param_global;
   int module_global;
-  jarray<float, 1>* modulated_curve_ptr;
+  int route_start;
+  int route_end;
+  jarray<float, 1>* modulated;
+  jarray<float, 1> const* automation;
 };
 
+// transform source, apply op and (for the last route on a target) clamp in one pass
+// broadcast values are read once up front, the compiler can't prove modulated doesn't alias them
+// min/max instead of std::clamp so the clamps map to minps/maxps, inputs are never nan
+// audio rate gets its own contiguous loop, a runtime stride doesn't vectorize
+template <int Type, bool Const, bool Clamp> static void
+cv_route_kernel(cv_route_args const& args)
+{
+  float const* source = args.source;
+  float const* target = args.target;
+  float* modulated = args.modulated;
+  float const const_min = args.min[0];
+  float const const_max = args.max[0];
+  float const const_scale = args.scale[0];
+  float const const_offset = args.offset[0];
+  auto frame = [&](int f) {
+    float min = Const ? const_min : args.min[f];
+    float max = Const ? const_max : args.max[f];
+    float scale = Const ? const_scale : args.scale[f];
+    float offset = Const ? const_offset : args.offset[f];
+    float transformed = std::max(0.0f, std::min((offset + source[f]) * scale, 1.0f));
+    float amount = min + (max - min) * transformed;
+    float m = modulated[f];
+    if constexpr (Type == type_mul_abs) m *= amount;
+    else if constexpr (Type == type_mul_rel) m = target[f] + amount * (1 - target[f]);
+    else if constexpr (Type == type_mul_stk) m = m + amount * (1 - m);
+    else if constexpr (Type == type_add_abs) m += amount;
+    else if constexpr (Type == type_add_rel) m += (1 - target[f]) * amount;
+    else if constexpr (Type == type_add_stk) m += (1 - m) * amount;
+    else if constexpr (Type == type_ab_abs) m += unipolar_to_bipolar(amount) * 0.5f;
+    else if constexpr (Type == type_ab_rel) m += (1 - std::fabs(0.5f - target[f]) * 2.0f) * unipolar_to_bipolar(amount) * 0.5f;
+    else if constexpr (Type == type_ab_stk) m += (1 - std::fabs(0.5f - m) * 2.0f) * unipolar_to_bipolar(amount) * 0.5f;
+    else static_assert(Type == type_ab_stk);
+    if constexpr (Clamp) m = std::max(0.0f, std::min(m, 1.0f));
+    modulated[f] = m;
+  };
+  if (args.step == 1)
+    for (int f = args.start_frame; f < args.end_frame; f++) frame(f);
+  else
+    for (int f = args.start_frame; f < args.end_frame; f += args.step) frame(f);
+}
+
+template <bool Const, bool Clamp> static void
+cv_route_apply(int type, cv_route_args const& args)
+{
+  switch (type)
+  {
+  case type_mul_abs: cv_route_kernel<type_mul_abs, Const, Clamp>(args); break;
+  case type_mul_rel: cv_route_kernel<type_mul_rel, Const, Clamp>(args); break;
+  case type_mul_stk: cv_route_kernel<type_mul_stk, Const, Clamp>(args); break;
+  case type_add_abs: cv_route_kernel<type_add_abs, Const, Clamp>(args); break;
+  case type_add_rel: cv_route_kernel<type_add_rel, Const, Clamp>(args); break;
+  case type_add_stk: cv_route_kernel<type_add_stk, Const, Clamp>(args); break;
+  case type_ab_abs: cv_route_kernel<type_ab_abs, Const, Clamp>(args); break;
+  case type_ab_rel: cv_route_kernel<type_ab_rel, Const, Clamp>(args); break;
+  case type_ab_stk: cv_route_kernel<type_ab_stk, Const, Clamp>(args); break;
+  default: assert(false); break;
+  }
+}
+
+// control rate also computes the last frame in the block so we can interpolate up to there
+template <bool Const, bool Clamp> static void
+cv_route_run(int type, cv_route_args args)
+{
+  cv_route_apply<Const, Clamp>(type, args);
+  int last_frame = args.end_frame - 1;
+  if (args.step == 1 || (last_frame - args.start_frame) % args.step == 0) return;
+  args.start_frame = last_frame;
+  cv_route_apply<Const, Clamp>(type, args);
+}
+
+// fill in the frames skipped by control rate routes
+static void
+cv_interpolate(float* curve, int start_frame, int end_frame, int step)
+{
+  int last_frame = end_frame - 1;
+  for (int f = start_frame; f < last_frame; f += step)
+  {
+    int next = std::min(f + step, last_frame);
+    float delta = (curve[next] - curve[f]) / (next - f);
+    for (int i = f + 1; i < next; i++)
+      curve[i] = curve[f] + delta * (i - f);
+  }
+}
+
+static int
+route_decimation(int rate)
+{ return rate == rate_audio ? 1 : 4 << rate; }
+
 static int
 route_count_from_module(int module)
 {
@@ -92,6 +213,35 @@ type_items()
   return result;
 }
 
+static std::vector<list_item>
+rate_items()
+{
+  std::vector<list_item> result;
+  result.emplace_back("{3F0E5C7A-8D41-4B6E-9A2C-71D5E8B4F092}", "Audio", "Audio Rate");
+  result.emplace_back("{A6D2B9E1-5C37-4F80-B1E4-2D9C6A7F8E13}", "8", "Control Rate, 8 Frames");
+  result.emplace_back("{5B8E1F4D-2A96-4C73-8E05-F3A7D1C9B264}", "16", "Control Rate, 16 Frames");
+  result.emplace_back("{E9C47A2B-6F18-4D5E-A3B0-8C2E5D9F1A75}", "32", "Control Rate, 32 Frames");
+  return result;
+}
+
+// lowest rate any active route reading from module/slot needs
+static int
+source_decimation(
+  plugin_block const& block, int matrix, int module, int slot,
+  std::vector<module_output_mapping> const& sources, int result)
+{
+  auto const& block_auto = block.state.all_block_automation[matrix][0];
+  int route_count = route_count_from_module(matrix);
+  for (int r = 0; r < route_count && result > 1; r++)
+  {
+    if (block_auto[param_type][r].step() == type_off) continue;
+    auto const& source = sources[block_auto[param_source][r].step()];
+    if (source.module_index != module || source.module_slot != slot) continue;
+    result = std::min(result, route_decimation(block_auto[param_rate][r].step()));
+  }
+  return result;
+}
+
 // shared cv->cv and cv->audio modulation
 class cv_matrix_engine_base :
 public module_engine {
@@ -99,8 +249,8 @@ protected:
 
   bool const _cv;
   bool const _global;
-  cv_matrix_mixdown _mixdown = {};
-  jarray<int, 4> _modulation_indices = {};
+  cv_matrix_mixdown _mixdown;
+  std::vector<std::vector<cv_cv_matrix_mixdown>> _module_mixdowns = {};
   std::vector<param_topo_mapping> const _targets;
   std::vector<module_output_mapping> const _sources;
 
@@ -110,6 +260,16 @@ protected:
   jarray<float, 3> const* _own_accurate_automation = {};
   jarray<plain_value, 2> const* _own_block_automation = {};
 
+  // routing compiled to a flat list of active routes grouped by target and targets 
+  // sorted by module, rebuilt only when op/source/target/rate of any route changes, so
+  // the per-block work is just running the plan and cv->cv mix() runs only its own range
+  bool _plan_valid = false;
+  int _plan_route_count = 0;
+  int _plan_target_count = 0;
+  std::array<int, max_any_route_count * plan_key_count> _plan_key = {};
+  std::array<cv_plan_route, max_any_route_count> _plan_routes = {};
+  std::array<cv_plan_target, max_any_route_count> _plan_targets = {};
+
   cv_matrix_engine_base(
     bool cv, bool global, plugin_topo const& topo,
     std::vector<module_output_mapping> const& sources,
@@ -118,6 +278,8 @@ protected:
   // module/slot:-1 is all (for cv->audio)
   // or specific module (for cv->cv)
   void perform_mixdown(plugin_block& block, int module, int slot);
+  void update_plan(plugin_block const& block);
+  void compile_plan(plugin_block const& block);
 
 public:
   void reset_audio(
@@ -127,22 +289,27 @@ public:
 };
 
 // mixes down into a single cv (entire module) on demand
+// global also needs the voice sources since voice routes can read global cv
 class cv_cv_matrix_engine :
 public cv_matrix_engine_base {
   cv_cv_matrix_mixer _mixer;
+  std::vector<module_output_mapping> const _voice_sources;
 
 public:
   cv_cv_matrix_engine(
     bool global, plugin_topo const& topo,
     std::vector<module_output_mapping> const& sources,
+    std::vector<module_output_mapping> const& voice_sources,
     std::vector<param_topo_mapping> const& targets):
-  cv_matrix_engine_base(true, global, topo, sources, targets), _mixer(this) {}
+  cv_matrix_engine_base(true, global, topo, sources, targets), 
+  _mixer(this), _voice_sources(voice_sources) {}
 
   PB_PREVENT_ACCIDENTAL_COPY(cv_cv_matrix_engine);
   void process_audio(plugin_block& block,
     std::vector<note_event> const* in_notes,
     std::vector<note_event>* out_notes) override;
   cv_cv_matrix_mixdown const& mix(plugin_block& block, int module, int slot);
+  int source_decimation(plugin_block const& block, int module, int slot) const;
 };
 
 // mixes down all cv to audio targets at once
@@ -479,10 +646,12 @@ cv_matrix_topo(
   };
   if(cv)
   {
+    std::vector<module_output_mapping> voice_sources;
+    if(global) voice_sources = make_cv_source_matrix(topo, make_cv_matrix_sources(topo, false, false)).mappings;
     result.gui.tabbed_name = "CV-CV";
-    result.engine_factory = [global, sm = source_matrix.mappings, tm = target_matrix.mappings](
+    result.engine_factory = [global, sm = source_matrix.mappings, vsm = voice_sources, tm = target_matrix.mappings](
       auto const& topo, int, int) {
-        return std::make_unique<cv_cv_matrix_engine>(global, topo, sm, tm);
+        return std::make_unique<cv_cv_matrix_engine>(global, topo, sm, vsm, tm);
     };
   }
   else
@@ -496,7 +665,7 @@ cv_matrix_topo(
 
   auto& main = result.sections.emplace_back(make_param_section(section_main,
     make_topo_tag_basic("{A19E18F8-115B-4EAB-A3C7-43381424E7AB}", "Main"),
-    make_param_section_gui({ 0, 0 }, { { 1 }, { gui_dimension::auto_size, 13, gui_dimension::auto_size, 4, 4, 4, 4 } })));
+    make_param_section_gui({ 0, 0 }, { { 1 }, { gui_dimension::auto_size, 13, gui_dimension::auto_size, 4, 4, 4, 4, gui_dimension::auto_size } })));
   main.gui.scroll_mode = gui_scroll_mode::vertical;
   
   auto& type = result.params.emplace_back(make_param(
@@ -589,6 +758,15 @@ cv_matrix_topo(
   max.gui.tabular = true;
   max.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] != type_off; });
   max.info.description = "Defines the bounds of the modulation effect. When min > max, modulation will invert.";
+  auto& rate = result.params.emplace_back(make_param(
+    make_topo_info_basic("{0C4D8E2F-7B31-4A96-B5E8-93F1A6C2D740}", "Rate", param_rate, route_count),
+    make_param_dsp_input(!global, param_automate::automate), make_domain_item(rate_items(), "Audio"),
+    make_param_gui(section_main, gui_edit_type::autofit_list, param_layout::vertical, { 0, 7 }, make_label_none())));
+  rate.gui.tabular = true;
+  rate.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return vs[0] != type_off; });
+  rate.info.description = std::string("Audio: modulation is computed every frame.<br/>") +
+    "8/16/32: modulation is computed once every 8/16/32 frames and linearly interpolated in between.<br/>" +
+    "A target stays at audio rate if any route to it does. LFOs run at control rate when all routes reading them do.";
 
   return result;
 }
@@ -598,11 +776,10 @@ cv_matrix_engine_base(
   bool cv, bool global, plugin_topo const& topo,
   std::vector<module_output_mapping> const& sources,
   std::vector<param_topo_mapping> const& targets):
-_cv(cv), _global(global), _sources(sources), _targets(targets)
+_cv(cv), _global(global), _mixdown(topo), _targets(targets), _sources(sources)
 {
-  plugin_dims dims(topo, topo.audio_polyphony);
-  _mixdown.resize(dims.module_slot_param_slot);
-  _modulation_indices.resize(dims.module_slot_param_slot);
+  for (int m = 0; m < topo.modules.size(); m++)
+    _module_mixdowns.emplace_back(topo.modules[m].info.slot_count);
 }
 
 void 
@@ -620,7 +797,23 @@ cv_cv_matrix_mixdown const&
 cv_cv_matrix_engine::mix(plugin_block& block, int module, int slot)
 {
   perform_mixdown(block, module, slot);
-  return _mixdown[module][slot];
+  return _module_mixdowns[module][slot];
+}
+
+int
+cv_cv_matrix_mixer::source_decimation(plugin_block const& block, int module, int slot)
+{ return _engine->source_decimation(block, module, slot); }
+
+// both matrices in this stage share the source list
+int
+cv_cv_matrix_engine::source_decimation(plugin_block const& block, int module, int slot) const
+{
+  int result = route_decimation(rate_32);
+  result = firefly_synth::source_decimation(block, module_from_matrix_type(true, _global), module, slot, _sources, result);
+  result = firefly_synth::source_decimation(block, module_from_matrix_type(false, _global), module, slot, _sources, result);
+  if (!_global) return result;
+  result = firefly_synth::source_decimation(block, module_vcv_cv_matrix, module, slot, _voice_sources, result);
+  return firefly_synth::source_decimation(block, module_vcv_audio_matrix, module, slot, _voice_sources, result);
 }
 
 void
@@ -646,200 +839,224 @@ cv_matrix_engine_base::reset_audio(
   _own_scratch = &block->state.own_scratch;
   _own_block_automation = &block->state.own_block_automation;
   _own_accurate_automation = &block->state.own_accurate_automation;
+
+  // plan holds pointers into block state
+  _plan_valid = false;
+  _mixdown.bind(block->plugin_desc_);
+  for (int m = 0; m < _module_mixdowns.size(); m++)
+    for (int mi = 0; mi < _module_mixdowns[m].size(); mi++)
+      _module_mixdowns[m][mi] = _mixdown.module_slot(m, mi);
 }
 
 void
-cv_matrix_engine_base::perform_mixdown(plugin_block& block, int module, int slot)
+cv_matrix_engine_base::update_plan(plugin_block const& block)
 {
-  // cv->cv matrix can modulate the cv->audio matrix
-  cv_cv_matrix_mixer* mixer = nullptr;
-  cv_cv_matrix_mixdown const* modulation = nullptr;
-  int this_module = _global ? module_gcv_cv_matrix : module_vcv_cv_matrix;
-  if (!_cv)
-  {
-    this_module = _global ? module_gcv_audio_matrix : module_vcv_audio_matrix;
-    mixer = &get_cv_cv_matrix_mixer(block, _global);
-    modulation = &mixer->mix(block, this_module, 0);
-  }
-
-  // set every modulatable parameter to its corresponding automation curve
-  assert((module == -1) == (slot == -1));
-  for (int m = 0; m < _targets.size(); m++)
-    if (module == -1 || (_targets[m].module_index == module && _targets[m].module_slot == slot))
+  bool changed = !_plan_valid;
+  int route_count = route_count_from_matrix_type(_cv, _global);
+  int const key_params[plan_key_count] = { param_type, param_source, param_target, param_rate };
+  for (int r = 0; r < route_count; r++)
+    for (int k = 0; k < plan_key_count; k++)
     {
-      int tp = _targets[m].param_index;
-      int tpi = _targets[m].param_slot;
-      int tm = _targets[m].module_index;
-      int tmi = _targets[m].module_slot;
-      _modulation_indices[tm][tmi][tp][tpi] = -1;
-      auto const& curve = block.state.all_accurate_automation[tm][tmi][tp][tpi];
-      _mixdown[tm][tmi][tp][tpi] = &curve;
+      int value = (*_own_block_automation)[key_params[k]][r].step();
+      changed |= _plan_key[r * plan_key_count + k] != value;
+      _plan_key[r * plan_key_count + k] = value;
     }
+  if (changed) compile_plan(block);
+}
 
-  // apply modulation routing
-  int modulation_index = 0;
-  int route_count = route_count_from_matrix_type(_global, _cv);
-  jarray<float, 1>* modulated_curve_ptrs[max_any_route_count] = { nullptr };
-  mod_output_usage mod_output_usages[max_any_route_count];
-  std::memset(&mod_output_usages, 0, sizeof(mod_output_usages));
+void
+cv_matrix_engine_base::compile_plan(plugin_block const& block)
+{
+  // set every modulatable parameter to its corresponding automation curve
+  for (int m = 0; m < _targets.size(); m++)
+  {
+    int tp = _targets[m].param_index;
+    int tpi = _targets[m].param_slot;
+    int tm = _targets[m].module_index;
+    int tmi = _targets[m].module_slot;
+    _mixdown.curve(tm, tmi, tp, tpi) = &block.state.all_accurate_automation[tm][tmi][tp][tpi];
+  }
 
+  // every modulated param gets one of our own cv outputs
+  _plan_valid = true;
+  _plan_route_count = 0;
+  _plan_target_count = 0;
+  int route_count = route_count_from_matrix_type(_cv, _global);
   for (int r = 0; r < route_count; r++)
   {
-    jarray<float, 1>* modulated_curve_ptr = nullptr;
-    int type = (*_own_block_automation)[param_type][r].step();
-    if (type == type_off) continue;
+    int const* key = &_plan_key[r * plan_key_count];
+    if (key[plan_key_type] == type_off) continue;
+    int selected_target = key[plan_key_target];
+    bool found = false;
+    for (int t = 0; t < _plan_target_count && !found; t++)
+      found = _plan_targets[t].target == selected_target;
+    if (found) continue;
 
-    // found out indices of modulation target
-    int selected_target = (*_own_block_automation)[param_target][r].step();
     int tp = _targets[selected_target].param_index;
     int tpi = _targets[selected_target].param_slot;
     int tm = _targets[selected_target].module_index;
     int tmi = _targets[selected_target].module_slot;
+    auto& target = _plan_targets[_plan_target_count];
+    target.target = selected_target;
+    target.decimation = route_decimation(rate_32);
+    target.module_index = tm;
+    target.module_slot = tmi;
+    target.modulated = &(*_own_cv)[0][_plan_target_count];
+    target.automation = &block.state.all_accurate_automation[tm][tmi][tp][tpi];
+    target.module_global = block.plugin_desc_.module_topo_to_index.at(tm) + tmi;
+    target.param_global = block.plugin_desc_.param_mappings.topo_to_index[tm][tmi][tp][tpi];
+    _mixdown.curve(tm, tmi, tp, tpi) = target.modulated;
+    _plan_target_count++;
+  }
 
-    if (module != -1 && (tm != module || tmi != slot)) continue;
-    auto const& target_curve = block.state.all_accurate_automation[tm][tmi][tp][tpi];
-
-    // if already modulated, set target curve to own buffer
-    int existing_modulation_index = _modulation_indices[tm][tmi][tp][tpi];
-    if (existing_modulation_index != -1)
-      modulated_curve_ptr = &(*_own_cv)[0][existing_modulation_index];
-    else
-    {
-      // else pick the next of our own cv outputs
-      modulated_curve_ptr = &(*_own_cv)[0][modulation_index];
-      auto const& target_automation = block.state.all_accurate_automation[tm][tmi][tp][tpi];
-      target_automation.copy_to(block.start_frame, block.end_frame, *modulated_curve_ptr);
-      modulated_curve_ptrs[r] = modulated_curve_ptr;
-      _mixdown[tm][tmi][tp][tpi] = modulated_curve_ptr;
-      _modulation_indices[tm][tmi][tp][tpi] = modulation_index;
-      
-      // set up for the visuals
-      mod_output_usages[modulation_index].in_use = true;
-      mod_output_usages[modulation_index].modulated_curve_ptr = modulated_curve_ptr;
-      mod_output_usages[modulation_index].module_global = block.plugin_desc_.module_topo_to_index.at(tm) + tmi;
-      mod_output_usages[modulation_index].param_global = block.plugin_desc_.param_mappings.topo_to_index[tm][tmi][tp][tpi];
-      modulation_index++;
-    }
-
-    assert(modulated_curve_ptr != nullptr);
-    jarray<float, 1>& modulated_curve = *modulated_curve_ptr;
-
-    // find out indices of modulation source
-    int selected_source = (*_own_block_automation)[param_source][r].step();
-    int sm = _sources[selected_source].module_index;
-    int smi = _sources[selected_source].module_slot;
-    int so = _sources[selected_source].output_index;
-    int soi = _sources[selected_source].output_slot;
-    auto const& source_curve = block.module_cv(sm, smi)[so][soi];
-
-    // source must be regular unipolar otherwise add/bi/mul breaks
-    for (int f = block.start_frame; f < block.end_frame; f++)
-      check_unipolar(source_curve[f]);
-
-    // pre-transform source signal, 
-    // cv->cv matrix can modulate transformation params (scale/offset) of the cv->audio matrix
-    jarray<float, 1> const* scale_curve_norm = nullptr;
-    jarray<float, 1> const* offset_curve_norm = nullptr;
-    if (_cv)
-    {
-      scale_curve_norm = &(*_own_accurate_automation)[param_scale][r];
-      offset_curve_norm = &(*_own_accurate_automation)[param_offset][r];
-    }
-    else
+  // stable sort on module so cv->cv mix() finds a contiguous range
+  for (int t = 1; t < _plan_target_count; t++)
+    for (int u = t; u > 0; u--)
     {
-      scale_curve_norm = (*modulation)[param_scale][r];
-      offset_curve_norm = (*modulation)[param_offset][r];
+      auto const& l = _plan_targets[u - 1];
+      auto const& r = _plan_targets[u];
+      if (l.module_index < r.module_index || (l.module_index == r.module_index && l.module_slot <= r.module_slot)) break;
+      std::swap(_plan_targets[u - 1], _plan_targets[u]);
     }
 
-    auto& scale_curve = (*_own_scratch)[scratch_scale];
-    auto& offset_curve = (*_own_scratch)[scratch_offset];
-    auto& transformed_source = (*_own_scratch)[scratch_transform_source];
-    block.normalized_to_raw_block<domain_type::linear>(this_module, param_scale, *scale_curve_norm, scale_curve);
-    block.normalized_to_raw_block<domain_type::linear>(this_module, param_offset, *offset_curve_norm, offset_curve);
-    for (int f = block.start_frame; f < block.end_frame; f++)
-      transformed_source[f] = std::clamp((offset_curve[f] + source_curve[f]) * scale_curve[f], 0.0f, 1.0f);
-
-    // apply modulation
-    // cv->cv matrix can modulate modulation params (min/max) of the cv->audio matrix
-    jarray<float, 1> const* min_curve = nullptr;
-    jarray<float, 1> const* max_curve = nullptr;
-    if (_cv)
-    {
-      min_curve = &(*_own_accurate_automation)[param_min][r];
-      max_curve = &(*_own_accurate_automation)[param_max][r];
-    }
-    else
+  // routes per target, in route order since stacked modulation depends on it
+  for (int t = 0; t < _plan_target_count; t++)
+  {
+    auto& target = _plan_targets[t];
+    target.route_start = _plan_route_count;
+    for (int r = 0; r < route_count; r++)
     {
-      min_curve = (*modulation)[param_min][r];
-      max_curve = (*modulation)[param_max][r];
+      int const* key = &_plan_key[r * plan_key_count];
+      if (key[plan_key_type] == type_off) continue;
+      if (key[plan_key_target] != target.target) continue;
+      auto const& source = _sources[key[plan_key_source]];
+      auto& route = _plan_routes[_plan_route_count++];
+      route.route = r;
+      route.type = key[plan_key_type];
+      target.decimation = std::min(target.decimation, route_decimation(key[plan_key_rate]));
+      route.source = &block.module_cv(source.module_index, source.module_slot)[source.output_index][source.output_slot];
     }
+    target.route_end = _plan_route_count;
+  }
+}
 
-    switch (type)
-    {
-    case type_mul_abs:
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        modulated_curve[f] *= (*min_curve)[f] + ((*max_curve)[f] - (*min_curve)[f]) * transformed_source[f];
-      break;
-    case type_mul_rel:
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        modulated_curve[f] = target_curve[f] + ((*min_curve)[f] + ((*max_curve)[f] - (*min_curve)[f]) * transformed_source[f]) * (1 - target_curve[f]);
-      break;
-    case type_mul_stk:
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        modulated_curve[f] = modulated_curve[f] + ((*min_curve)[f] + ((*max_curve)[f] - (*min_curve)[f]) * transformed_source[f]) * (1 - modulated_curve[f]);
-      break;
-    case type_add_abs:
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        modulated_curve[f] += (*min_curve)[f] + ((*max_curve)[f] - (*min_curve)[f]) * transformed_source[f];
-      break;
-    case type_add_rel:
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        modulated_curve[f] += (1 - target_curve[f]) * ((*min_curve)[f] + ((*max_curve)[f] - (*min_curve)[f]) * transformed_source[f]);
-      break;
-    case type_add_stk:
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        modulated_curve[f] += (1 - modulated_curve[f]) * ((*min_curve)[f] + ((*max_curve)[f] - (*min_curve)[f]) * transformed_source[f]);
-      break;
-    case type_ab_abs:
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        modulated_curve[f] += unipolar_to_bipolar((*min_curve)[f] + ((*max_curve)[f] - (*min_curve)[f]) * transformed_source[f]) * 0.5f;
-      break;
-    case type_ab_rel:
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        modulated_curve[f] += (1 - std::fabs(0.5f - target_curve[f]) * 2.0f) * unipolar_to_bipolar((*min_curve)[f] + ((*max_curve)[f] - (*min_curve)[f]) * transformed_source[f]) * 0.5f;
-      break;
-    case type_ab_stk:
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        modulated_curve[f] += (1 - std::fabs(0.5f - modulated_curve[f]) * 2.0f) * unipolar_to_bipolar((*min_curve)[f] + ((*max_curve)[f] - (*min_curve)[f]) * transformed_source[f]) * 0.5f;
-      break;
-    default:
-      assert(false);
-      break;
-    }
+void
+cv_matrix_engine_base::perform_mixdown(plugin_block& block, int module, int slot)
+{
+  // cv->cv matrix can modulate the cv->audio matrix
+  cv_cv_matrix_mixer* mixer = nullptr;
+  cv_cv_matrix_mixdown const* modulation = nullptr;
+  int this_module = _global ? module_gcv_cv_matrix : module_vcv_cv_matrix;
+  if (!_cv)
+  {
+    this_module = _global ? module_gcv_audio_matrix : module_vcv_audio_matrix;
+    mixer = &get_cv_cv_matrix_mixer(block, _global);
+    modulation = &mixer->mix(block, this_module, 0);
   }
 
-  // clamp, modulated_curve_ptrs[r] will point to the first 
-  // occurence of modulation, but mod effects are accumulated there
-  for (int r = 0; r < route_count; r++)
-    if (modulated_curve_ptrs[r] != nullptr)
-      modulated_curve_ptrs[r]->transform(block.start_frame, block.end_frame, [](float v) { return std::clamp(v, 0.0f, 1.0f); });
+  // find out which part of the plan to run
+  assert((module == -1) == (slot == -1));
+  update_plan(block);
+  int target_start = 0;
+  int target_end = _plan_target_count;
+  if (module != -1)
+  {
+    while (target_start < _plan_target_count && (_plan_targets[target_start].module_index != module || _plan_targets[target_start].module_slot != slot)) 
+      target_start++;
+    target_end = target_start;
+    while (target_end < _plan_target_count && _plan_targets[target_end].module_index == module && _plan_targets[target_end].module_slot == slot) 
+      target_end++;
+  }
 
-  // push param modulation outputs 
-  if (block.graph) return;
+  for (int t = target_start; t < target_end; t++)
+  {
+    auto const& target = _plan_targets[t];
+    jarray<float, 1>& modulated_curve = *target.modulated;
+    jarray<float, 1> const& target_curve = *target.automation;
+    target_curve.copy_to(block.start_frame, block.end_frame, modulated_curve);
 
-  for (int r = 0; r < route_count; r++)
-    if (mod_output_usages[r].in_use)
+    for (int pr = target.route_start; pr < target.route_end; pr++)
     {
-      // debugging
-      auto const& param_desc = block.plugin_desc_.params[mod_output_usages[r].param_global];
-      (void)param_desc;
-
-      block.push_modulation_output(modulation_output::make_mod_output_param_state(
-        _global ? -1 : block.voice->state.slot,
-        mod_output_usages[r].module_global,
-        mod_output_usages[r].param_global,
-        (*mod_output_usages[r].modulated_curve_ptr)[block.end_frame - 1]));
+      int r = _plan_routes[pr].route;
+      int type = _plan_routes[pr].type;
+      auto const& source_curve = *_plan_routes[pr].source;
+
+      // source must be regular unipolar otherwise add/bi/mul breaks
+      for (int f = block.start_frame; f < block.end_frame; f++)
+        check_unipolar(source_curve[f]);
+
+      // cv->cv matrix can modulate transformation params (scale/offset) 
+      // and modulation params (min/max) of the cv->audio matrix
+      jarray<float, 1> const* scale_curve_norm = nullptr;
+      jarray<float, 1> const* offset_curve_norm = nullptr;
+      jarray<float, 1> const* min_curve = nullptr;
+      jarray<float, 1> const* max_curve = nullptr;
+      if (_cv)
+      {
+        min_curve = &(*_own_accurate_automation)[param_min][r];
+        max_curve = &(*_own_accurate_automation)[param_max][r];
+        scale_curve_norm = &(*_own_accurate_automation)[param_scale][r];
+        offset_curve_norm = &(*_own_accurate_automation)[param_offset][r];
+      }
+      else
+      {
+        min_curve = (*modulation)[param_min][r];
+        max_curve = (*modulation)[param_max][r];
+        scale_curve_norm = (*modulation)[param_scale][r];
+        offset_curve_norm = (*modulation)[param_offset][r];
+      }
+
+      cv_route_args args = {};
+      args.step = target.decimation;
+      args.start_frame = block.start_frame;
+      args.end_frame = block.end_frame;
+      args.source = source_curve.data().data();
+      args.target = target_curve.data().data();
+      args.modulated = modulated_curve.data().data();
+      bool clamp = pr == target.route_end - 1;
+
+      // broadcast if nothing is modulated or automated
+      bool is_constant = min_curve->is_constant(block.start_frame, block.end_frame) &&
+        max_curve->is_constant(block.start_frame, block.end_frame) &&
+        scale_curve_norm->is_constant(block.start_frame, block.end_frame) &&
+        offset_curve_norm->is_constant(block.start_frame, block.end_frame);
+      if (is_constant)
+      {
+        float min = (*min_curve)[block.start_frame];
+        float max = (*max_curve)[block.start_frame];
+        float scale = block.normalized_to_raw_fast<domain_type::linear>(this_module, param_scale, (*scale_curve_norm)[block.start_frame]);
+        float offset = block.normalized_to_raw_fast<domain_type::linear>(this_module, param_offset, (*offset_curve_norm)[block.start_frame]);
+        args.min = &min;
+        args.max = &max;
+        args.scale = &scale;
+        args.offset = &offset;
+        if (clamp) cv_route_run<true, true>(type, args);
+        else cv_route_run<true, false>(type, args);
+        continue;
+      }
+
+      auto& scale_curve = (*_own_scratch)[scratch_scale];
+      auto& offset_curve = (*_own_scratch)[scratch_offset];
+      block.normalized_to_raw_block<domain_type::linear>(this_module, param_scale, *scale_curve_norm, scale_curve);
+      block.normalized_to_raw_block<domain_type::linear>(this_module, param_offset, *offset_curve_norm, offset_curve);
+      args.min = min_curve->data().data();
+      args.max = max_curve->data().data();
+      args.scale = scale_curve.data().data();
+      args.offset = offset_curve.data().data();
+      if (clamp) cv_route_run<false, true>(type, args);
+      else cv_route_run<false, false>(type, args);
     }
-}
 
+    if (target.decimation > 1)
+      cv_interpolate(modulated_curve.data().data(), block.start_frame, block.end_frame, target.decimation);
+
+    // push param modulation outputs
+    if (block.graph) continue;
+    block.push_modulation_output(modulation_output::make_mod_output_param_state(
+      _global ? -1 : block.voice->state.slot,
+      target.module_global, target.param_global,
+      modulated_curve[block.end_frame - 1]));
+  }
 }
+
+}
\ No newline at end of file
@@ -35,6 +35,17 @@ enum {
 
 static int const route_count = 10;
 
+// am route targeting a single osc, with unison voice lerp precomputed
+struct am_route
+{
+  jarray<float, 1> const* amt_curve;
+  jarray<float, 1> const* ring_curve;
+  jarray<float, 3> const* source_audio;
+  std::array<int, max_osc_unison_voices> source_voice_0;
+  std::array<int, max_osc_unison_voices> source_voice_1;
+  std::array<float, max_osc_unison_voices> source_voice_pos;
+};
+
 std::unique_ptr<graph_engine> make_osc_graph_engine(plugin_desc const* desc);
 std::vector<graph_data> render_osc_graphs(
   plugin_state const& state, graph_engine* engine, int slot, 
@@ -55,8 +66,8 @@ public module_engine {
   jarray<float, 2> _no_fm = {};
   jarray<float, 3> _fm_modsig = {};
   osc_osc_matrix_context _context = {};
-  jarray<float, 4>* _own_audio = {};
   jarray<float, 2>* _own_scratch = {};
+  std::array<am_route, route_count> _am_routes = {};
   osc_osc_matrix_am_modulator _am_modulator;
   osc_osc_matrix_fm_modulator _fm_modulator;
 public:
@@ -70,9 +81,10 @@ public:
     std::vector<note_event> const* in_notes,
     std::vector<note_event>* out_notes) override;
 
-  jarray<float, 3> const& modulate_am(
+  void modulate_am(
     plugin_block& block, int slot, 
-    cv_audio_matrix_mixdown const* cv_modulation);
+    cv_audio_matrix_mixdown const* cv_modulation,
+    jarray<float, 3>& audio, float uni_attn);
 
   template <bool Graph>
   jarray<float, 2> const& modulate_fm(
@@ -126,18 +138,13 @@ make_audio_routing_osc_mod_params(plugin_state* state)
 module_topo 
 osc_osc_matrix_topo(int section, gui_position const& pos, plugin_topo const* plugin)
 {
-  std::vector<module_dsp_output> outputs;
   auto osc_matrix = make_audio_matrix({ &plugin->modules[module_osc] }, 0, true);
 
-  // scratch state for AM
+  // AM is applied in-place on the oscillator output
   // for FM we use oversampled mono series
-  for(int r = 0; r < route_count; r++)
-    outputs.push_back(make_module_dsp_output(false, -1, make_topo_info_basic(
-      "{1DABDF9D-E777-44FF-9720-3B09AAF07C6D}-" + std::to_string(r), "AM", r, max_osc_unison_voices + 1)));
-
   module_topo result(make_module(
     make_topo_info_basic("{8024F4DC-5BFC-4C3D-8E3E-C9D706787362}", "Osc Mod", module_osc_osc_matrix, 1),
-    make_module_dsp(module_stage::voice, module_output::audio, scratch_count, outputs),
+    make_module_dsp(module_stage::voice, module_output::none, scratch_count, {}),
     make_module_gui(section, pos, { { 1 }, { 1, 1 } })));
   result.info.description = "Oscillator routing matrices that allow for Osc-to-Osc AM, RM and FM.";
 
@@ -277,11 +284,12 @@ _am_modulator(this), _fm_modulator(this)
 }
 
 // unison-channel-frame
-jarray<float, 3> const&
+void
 osc_osc_matrix_am_modulator::modulate_am(
   plugin_block& block, int slot, 
-  cv_audio_matrix_mixdown const* cv_modulation)
-{ return _engine->modulate_am(block, slot, cv_modulation); }
+  cv_audio_matrix_mixdown const* cv_modulation,
+  jarray<float, 3>& audio, float uni_attn)
+{ _engine->modulate_am(block, slot, cv_modulation, audio, uni_attn); }
 
 // unison-(frame*oversmp)
 template <bool Graph>
@@ -308,24 +316,25 @@ osc_osc_matrix_engine::process_audio(
   // need to capture stuff here because when we start 
   // modulating "own" does not refer to us but to the caller
   *block.state.own_context = &_context;
-  _own_audio = &block.state.own_audio;
   _own_scratch = &block.state.own_scratch;
 }
 
-// This returns the final output signal i.e. all modulators applied to carrier.
-jarray<float, 3> const& 
+// This applies all modulators to the carrier in-place, and writes the unison total.
+// Single pass over the output, all modulators for a frame are applied before 
+// writing back so self-modulation still sees the unmodulated carrier.
+void
 osc_osc_matrix_engine::modulate_am(
-  plugin_block& block, int slot, cv_audio_matrix_mixdown const* cv_modulation)
+  plugin_block& block, int slot, cv_audio_matrix_mixdown const* cv_modulation,
+  jarray<float, 3>& audio, float uni_attn)
 {
   // allow custom data for graphs
   if(cv_modulation == nullptr)
     cv_modulation = &get_cv_audio_matrix_mixdown(block, false);
 
-  // loop through the routes
-  // the first match we encounter becomes the modulation result
-  jarray<float, 3>* modulated = nullptr;
-  jarray<float, 3> const& target_audio = block.voice->all_audio[module_osc][slot][0];
+  // gather the routes targeting us
+  int am_route_count = 0;
   auto const& block_auto = block.state.all_block_automation[module_osc_osc_matrix][0];
+  int target_uni_voices = block.state.all_block_automation[module_osc][slot][osc_param_uni_voices][0].step();
 
   for (int r = 0; r < route_count; r++)
   {
@@ -333,58 +342,64 @@ osc_osc_matrix_engine::modulate_am(
     int target_osc = block_auto[param_am_target][r].step();
     if(target_osc != slot) continue;
 
-    int target_uni_voices = block.state.all_block_automation[module_osc][target_osc][osc_param_uni_voices][0].step();
-    if (modulated == nullptr)
-    {
-      modulated = &(*_own_audio)[r];
-      for (int v = 0; v < target_uni_voices; v++)
-      {
-        // base value is the unmodulated target (carrier)
-        // then keep multiplying by modulators
-        target_audio[v + 1][0].copy_to(block.start_frame, block.end_frame, (*modulated)[v + 1][0]);
-        target_audio[v + 1][1].copy_to(block.start_frame, block.end_frame, (*modulated)[v + 1][1]);
-      }
-    }
-
     // apply modulation on per unison voice level
     // mapping both source count and target count to [0, 1]
     // then linear interpolate. this allows modulation
     // between oscillators with unequal unison voice count
+    auto& route = _am_routes[am_route_count++];
     int source_osc = block_auto[param_am_source][r].step();
-    auto const& source_audio = block.module_audio(module_osc, source_osc);
-    auto const& amt_curve = *(*cv_modulation)[module_osc_osc_matrix][0][param_am_amt][r];
-    auto const& ring_curve = *(*cv_modulation)[module_osc_osc_matrix][0][param_am_ring][r];
     int source_uni_voices = block.state.all_block_automation[module_osc][source_osc][osc_param_uni_voices][0].step();
-
+    route.source_audio = &block.module_audio(module_osc, source_osc)[0];
+    route.amt_curve = (*cv_modulation)[module_osc_osc_matrix][0][param_am_amt][r];
+    route.ring_curve = (*cv_modulation)[module_osc_osc_matrix][0][param_am_ring][r];
     for(int v = 0; v < target_uni_voices; v++)
     {
       // lerp unison voices
       float target_voice_pos = target_uni_voices == 1? 0.5f: v / (target_uni_voices - 1.0f);
       float source_voice = target_voice_pos * (source_uni_voices - 1);
-      int source_voice_0 = (int)source_voice;
-      int source_voice_1 = source_voice_0 + 1;
-      float source_voice_pos = source_voice - (int)source_voice;
-      if(source_voice_1 == source_uni_voices) source_voice_1--;
+      route.source_voice_0[v] = (int)source_voice;
+      route.source_voice_1[v] = route.source_voice_0[v] + 1;
+      route.source_voice_pos[v] = source_voice - (int)source_voice;
+      if(route.source_voice_1[v] == source_uni_voices) route.source_voice_1[v]--;
+    }
+  }
+
+  // default result is unmodulated (e.g., osc output itself)
+  std::array<float, max_osc_unison_voices> modulated;
+  for(int c = 0; c < 2; c++)
+    for(int f = block.start_frame; f < block.end_frame; f++)
+    {
+      for (int v = 0; v < target_uni_voices; v++)
+        modulated[v] = audio[v + 1][c][f];
 
-      for(int c = 0; c < 2; c++)
-        for(int f = block.start_frame; f < block.end_frame; f++)
+      // base value is the unmodulated target (carrier)
+      // then keep multiplying by modulators
+      for (int r = 0; r < am_route_count; r++)
+      {
+        auto const& route = _am_routes[r];
+        float amt = (*route.amt_curve)[f];
+        float ring = (*route.ring_curve)[f];
+        for (int v = 0; v < target_uni_voices; v++)
         {
-          float audio = (*modulated)[v + 1][c][f];
           // do not assume [-1, 1] here as oscillator can go beyond that
-          float rm0 = source_audio[0][source_voice_0 + 1][c][f];
-          float rm1 = source_audio[0][source_voice_1 + 1][c][f];
-          float rm = (1 - source_voice_pos) * rm0 + source_voice_pos * rm1;
+          float rm0 = (*route.source_audio)[route.source_voice_0[v] + 1][c][f];
+          float rm1 = (*route.source_audio)[route.source_voice_1[v] + 1][c][f];
+          float rm = (1 - route.source_voice_pos[v]) * rm0 + route.source_voice_pos[v] * rm1;
           // "bipolar to unipolar" for [-inf, +inf]
           float am = (rm * 0.5f) + 0.5f;
-          float mod = mix_signal(ring_curve[f], am, rm);
-          (*modulated)[v + 1][c][f] = mix_signal(amt_curve[f], audio, mod * audio);
+          float mod = mix_signal(ring, am, rm);
+          modulated[v] = mix_signal(amt, modulated[v], mod * modulated[v]);
         }
-    }
-  }
+      }
 
-  // default result is unmodulated (e.g., osc output itself)
-  if(modulated != nullptr) return *modulated;
-  return block.voice->all_audio[module_osc][slot][0];
+      float uni_total = 0;
+      for (int v = 0; v < target_uni_voices; v++)
+      {
+        uni_total += modulated[v];
+        audio[v + 1][c][f] = modulated[v];
+      }
+      audio[0][c][f] = uni_total / uni_attn;
+    }
 }
 
 // This returns stacked modulators but doesnt touch the carrier.
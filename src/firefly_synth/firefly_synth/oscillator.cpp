@@ -28,7 +28,7 @@ enum {
 
 enum {
   param_type, param_gain, param_note, param_cent, 
-  param_hard_sync, param_hard_sync_semis, param_hard_sync_xover,
+  param_hard_sync, param_hard_sync_blep, param_hard_sync_semis, param_hard_sync_xover,
   param_uni_voices, param_uni_sprd, param_uni_dtn, param_uni_phase,
   param_basic_sin_on, param_basic_sin_mix, param_basic_saw_on, param_basic_saw_mix,
   param_basic_tri_on, param_basic_tri_mix, param_basic_sqr_on, param_basic_sqr_mix, param_basic_sqr_pw,
@@ -52,40 +52,66 @@ static bool can_do_pitch(int type)
 
 // bit different for osci and lfo
 // lfo is bucket based but for this one we'd need up to SR/2 buckets
+// all lanes (unison voices) step in lockstep, only the seed differs
+// next() only runs the first count lanes, i.e. the active unison voices
+template <int Lanes>
 class static_noise
 {
   int _pos = 0;
   int _samples = 0;
-  float _level = 0;
-  std::uint32_t _state = 1;
+  float _sr = 0;
+  float _rate = 0;
+  std::array<float, Lanes> _levels = {};
+  std::array<std::uint32_t, Lanes> _states = {};
 
 public:
 
-  float next();
   void reset(int seed);
-  void update(float sr, float rate) { _samples = std::ceil(sr / rate); }
+  void next(float* out, int count = Lanes);
+  void update(float sr, float rate);
 };
 
-inline void
-static_noise::reset(int seed)
+template <int Lanes> inline void
+static_noise<Lanes>::reset(int seed)
 {
   _pos = 0;
-  _state = plugin_base::fast_rand_seed(seed);
-  _level = plugin_base::fast_rand_next(_state);
+  for (int l = 0; l < Lanes; l++)
+  {
+    _states[l] = plugin_base::fast_rand_seed(seed + l);
+    _levels[l] = plugin_base::fast_rand_next(_states[l]);
+  }
 }
 
-inline float
-static_noise::next()
+template <int Lanes> inline void
+static_noise<Lanes>::update(float sr, float rate)
 {
-  _pos++;
-  float result = _level;
-  if (_pos >= _samples)
-  {
-    _level = plugin_base::fast_rand_next(_state);
-    _level = bipolar_to_unipolar(unipolar_to_bipolar(_level));
-    _pos = 0;
-  }
-  return result;
+  if (sr == _sr && rate == _rate) return;
+  _sr = sr;
+  _rate = rate;
+  _samples = std::ceil(sr / rate);
+}
+
+template <int Lanes> inline void
+static_noise<Lanes>::next(float* out, int count)
+{
+  assert(0 < count && count <= Lanes);
+  for (int l = 0; l < count; l++)
+    out[l] = _levels[l];
+  if (++_pos < _samples) return;
+  _pos = 0;
+  for (int l = 0; l < count; l++)
+    _levels[l] = bipolar_to_unipolar(unipolar_to_bipolar(plugin_base::fast_rand_next(_states[l])));
+}
+
+template <int SVFType> static void
+init_random_svf(state_var_filter_coeffs& coeffs, double w, double res)
+{
+  if constexpr (SVFType == rand_svf_lpf) coeffs.init_lpf(w, res);
+  else if constexpr (SVFType == rand_svf_hpf) coeffs.init_hpf(w, res);
+  else if constexpr (SVFType == rand_svf_bpf) coeffs.init_bpf(w, res);
+  else if constexpr (SVFType == rand_svf_bsf) coeffs.init_bsf(w, res);
+  else if constexpr (SVFType == rand_svf_peq) coeffs.init_peq(w, res);
+  else assert(false);
 }
 
 static void
@@ -140,6 +166,13 @@ public module_engine {
   // for lerp hardsync
   int _unsync_samples[max_osc_unison_voices];
   float _unsync_phases[max_osc_unison_voices];
+  // for blep hardsync, correction for the sample after the reset
+  // that sample is rendered naive, so the builtin wrap correction of
+  // the waveforms does not come on top of it
+  bool _sync_blep_due[max_osc_unison_voices];
+  float _sync_bleps[max_osc_unison_voices];
+  // dsf, follows the synced phase
+  std::array<dsf_generator<int>, max_osc_unison_voices> _dsf_generators = {};
 
   // oversampler and pointers into upsampled buffers
   oscillator_context _context = {};
@@ -148,9 +181,11 @@ public module_engine {
   // random (static and k+s)
   std::array<dc_filter, max_osc_unison_voices> _random_dcs = {};
 
-  // static
-  std::array<static_noise, max_osc_unison_voices> _static_noises = {};
-  std::array<state_var_filter, max_osc_unison_voices> _static_svfs = {};
+  // static, all unison voices at once
+  std::array<float, max_osc_unison_voices> _static_samples = {};
+  dc_filter_lanes<max_osc_unison_voices> _static_dc = {};
+  static_noise<max_osc_unison_voices> _static_noise = {};
+  state_var_filter_lanes<max_osc_unison_voices, float> _static_svf = {};
 
   // kps
   int _kps_max_length = {};
@@ -180,7 +215,7 @@ public:
 private:
 
   template <int SVFType>
-  float generate_static(int voice, float sr, float freq_hz, float res, int seed, float rate_hz);
+  void generate_static(int lanes, float sr, float freq_hz, float res, float rate_hz);
   template <bool AutoFdbk>
   float generate_kps(int voice, float sr, float freq, float fdbk, float stretch, float mid_freq);
 
@@ -392,6 +427,14 @@ osc_topo(int section, gui_position const& pos)
       make_label(gui_label_contents::name, gui_label_align::top, gui_label_justify::center))));
   sync_on.gui.bindings.enabled.bind_params({ param_type }, [](auto const& vs) { return can_do_phase(vs[0]); });
   sync_on.info.description = "Enables hard-sync against an internal reference oscillator.";
+  auto& sync_blep = result.params.emplace_back(make_param(
+    make_topo_info("{2252C30E-801B-4D6F-8291-C5FA9B3D1067}", true, "Hard Sync BLEP", "BLEP", "HS BLEP", param_hard_sync_blep, 1),
+    make_param_dsp_voice(param_automate::automate), make_domain_toggle(false),
+    make_param_gui_single(section_sync_on, gui_edit_type::toggle, { 1, 0 },
+      make_label(gui_label_contents::name, gui_label_align::top, gui_label_justify::center))));
+  sync_blep.gui.bindings.enabled.bind_params({ param_type, param_hard_sync }, [](auto const& vs) { return can_do_phase(vs[0]) && vs[1]; });
+  sync_blep.info.description = std::string("Smooths out the phase reset using a BLEP instead of crossing over to the unsynced signal. ") +
+    "Cheaper than cross-over, since no unsynced signal is generated.";
 
   auto& sync_uni_section = result.sections.emplace_back(make_param_section(section_sync_uni,
     make_topo_tag_basic("{18204EB2-1066-4F27-8FD9-5C3D1505BDD7}", "Sync/Unisonc Params"),
@@ -410,7 +453,7 @@ osc_topo(int section, gui_position const& pos)
     make_param_dsp_voice(param_automate::automate), make_domain_linear(0, 5, 2.5, 2, "Ms"),
     make_param_gui_single(section_sync_uni, gui_edit_type::knob, { 1, 0 },
       make_label(gui_label_contents::name, gui_label_align::left, gui_label_justify::near))));
-  sync_xover.gui.bindings.enabled.bind_params({ param_type, param_hard_sync }, [](auto const& vs) { return can_do_phase(vs[0]) && vs[1]; });
+  sync_xover.gui.bindings.enabled.bind_params({ param_type, param_hard_sync, param_hard_sync_blep }, [](auto const& vs) { return can_do_phase(vs[0]) && vs[1] && !vs[2]; });
   sync_xover.info.description = "Controls cross-over time between the synced and unsyced signal after a phase reset occurs.";
   auto& uni_voices = result.params.emplace_back(make_param(
     make_topo_info("{376DE9EF-1CC4-49A0-8CA7-9CF20D33F4D8}", true, "Unison Voices", "Uni", "Uni", param_uni_voices, 1),
@@ -700,6 +743,42 @@ generate_sqr(float phase, float increment, float pwm)
   return (saw1 - saw2) * 0.5f;
 }
 
+// per-frame generator params, shared by the synced and unsynced phase
+struct osc_wave_input
+{
+  float sin_mix;
+  float saw_mix;
+  float tri_mix;
+  float sqr_mix;
+  float sqr_pw;
+  // initialized per unison voice, running = false for 
+  // evaluations off the regular phase (sync crossover and bleps)
+  bool dsf_running;
+  dsf_generator<int>* dsf;
+};
+
+// inc = 0 gives the naive (not bandlimited) waveform
+template <bool Sin, bool Saw, bool Tri, bool Sqr, bool DSF> static inline float
+generate_wave(float phase, float inc, osc_wave_input const& in)
+{
+  float result = 0;
+  if constexpr (Saw) result += generate_saw(phase, inc) * in.saw_mix;
+  if constexpr (Sin) result += std::sin(2.0f * pi32 * phase) * in.sin_mix;
+  if constexpr (Tri) result += generate_triangle(phase, inc) * in.tri_mix;
+  if constexpr (Sqr) result += generate_sqr(phase, inc, in.sqr_pw) * in.sqr_mix;
+  if constexpr (DSF) result = in.dsf_running ? in.dsf->next(phase, inc) : in.dsf->eval(phase);
+  return result;
+}
+
+static inline void
+apply_phase_fm(float& phase, float fm)
+{
+  phase += fm;
+  if (phase < 0 || phase >= 1) phase -= std::floor(phase);
+  if (phase == 1) phase = 0; // this could be more efficient?
+  assert(0 <= phase && phase < 1);
+}
+
 osc_engine::
 osc_engine(int max_frame_count, float sample_rate):
 _oversampler(max_frame_count)
@@ -745,16 +824,19 @@ osc_engine::real_reset(plugin_block& block, cv_audio_matrix_mixdown const* modul
   // Not a continuous param but we fake it this way so it can participate in modulation.
   float uni_phase = (*(*modulation)[module_osc][block.module_slot][param_uni_phase][0])[0];
 
+  // Unison over static noise doesnt do detune, but it can stereo spread.
+  // Static noise, filter and dc blocker run all unison voices in lockstep.
+  _static_svf.clear();
+  _static_dc.init(block.sample_rate, 20);
+  _static_noise.reset(block_auto[param_rand_seed][0].step());
+
   for (int v = 0; v < uni_voices; v++)
   {
-    _static_svfs[v].clear();
-
-    // Unison over static noise doesnt do detune, but it can stereo spread.
-    _static_noises[v].reset(block_auto[param_rand_seed][0].step() + v);
-
     // Block below 20hz, certain param combinations generate very low frequency content
     _random_dcs[v].init(block.sample_rate, 20);
 
+    _dsf_generators[v].reset();
+
     // Adjust phase for osc unison.
     _ref_phases[v] = (float)v / uni_voices * (uni_voices == 1 ? 0.0f : uni_phase);
 
@@ -767,6 +849,8 @@ osc_engine::real_reset(plugin_block& block, cv_audio_matrix_mixdown const* modul
       _ref_phases[v] -= (int)_ref_phases[v];
     }
 
+    _sync_bleps[v] = 0;
+    _sync_blep_due[v] = false;
     _sync_phases[v] = _ref_phases[v];
     _unsync_phases[v] = 0;
     _unsync_samples[v] = 0;
@@ -789,8 +873,9 @@ osc_engine::real_reset(plugin_block& block, cv_audio_matrix_mixdown const* modul
   float kps_rate = block.normalized_to_raw_fast<domain_type::log>(module_osc, param_rand_rate, kps_rate_normalized);
 
   // Initial white noise + filter amount.
-  state_var_filter filter = {};
-  static_noise static_noise_ = {};
+  state_var_filter_coeffs coeffs = {};
+  state_var_filter_lanes<1> filter;
+  static_noise<1> static_noise_ = {};
 
   // below 50 hz gives barely any results
   float rate = 50 + (kps_rate * 0.01) * (block.sample_rate * 0.5f - 50);
@@ -799,13 +884,15 @@ osc_engine::real_reset(plugin_block& block, cv_audio_matrix_mixdown const* modul
   double w = pi64 * kps_freq / block.sample_rate;
   switch (kps_svf)
   {
-  case rand_svf_lpf: filter.init_lpf(w, kps_res * kps_max_res); break;
-  case rand_svf_hpf: filter.init_hpf(w, kps_res * kps_max_res); break;
-  case rand_svf_bpf: filter.init_bpf(w, kps_res * kps_max_res); break;
-  case rand_svf_bsf: filter.init_bsf(w, kps_res * kps_max_res); break;
-  case rand_svf_peq: filter.init_peq(w, kps_res * kps_max_res); break;
+  case rand_svf_lpf: coeffs.init_lpf(w, kps_res * kps_max_res); break;
+  case rand_svf_hpf: coeffs.init_hpf(w, kps_res * kps_max_res); break;
+  case rand_svf_bpf: coeffs.init_bpf(w, kps_res * kps_max_res); break;
+  case rand_svf_bsf: coeffs.init_bsf(w, kps_res * kps_max_res); break;
+  case rand_svf_peq: coeffs.init_peq(w, kps_res * kps_max_res); break;
   default: assert(false); break;
   }
+  filter.clear();
+  filter.init(coeffs);
   for (int v = 0; v < max_osc_unison_voices; v++)
   {
     // we fix length at first call to generate_kps
@@ -814,40 +901,30 @@ osc_engine::real_reset(plugin_block& block, cv_audio_matrix_mixdown const* modul
     _kps_positions[v] = 0;
     for (int f = 0; f < _kps_max_length; f++)
     {
-      float noise = static_noise_.next();
-      _kps_lines[v][f] = filter.next(0, unipolar_to_bipolar(noise));
+      float noise;
+      static_noise_.next(&noise);
+      noise = unipolar_to_bipolar(noise);
+      filter.next(&noise);
+      _kps_lines[v][f] = noise;
     }
   }
 }
 
-template <int SVFType>
-float osc_engine::generate_static(int voice, float sr, float freq_hz, float res, int seed, float rate_hz)
+template <int SVFType> void
+osc_engine::generate_static(int lanes, float sr, float freq_hz, float res, float rate_hz)
 {
-  _static_noises[voice].update(sr, rate_hz);
-  float result = unipolar_to_bipolar(_static_noises[voice].next());
-
   float const max_res = 0.99f;
   double w = pi64 * freq_hz / sr;
-  if constexpr (SVFType == rand_svf_lpf)
-    _static_svfs[voice].init_lpf(w, res * max_res);
-  else if constexpr (SVFType == rand_svf_hpf)
-    _static_svfs[voice].init_hpf(w, res * max_res);
-  else if constexpr (SVFType == rand_svf_bpf)
-    _static_svfs[voice].init_bpf(w, res * max_res);
-  else if constexpr (SVFType == rand_svf_bsf)
-    _static_svfs[voice].init_bsf(w, res * max_res);
-  else if constexpr (SVFType == rand_svf_peq)
-    _static_svfs[voice].init_peq(w, res * max_res);
-  else
-  {
-    // cannot got a static_assert here that works on both msvc and gcc
-    assert(false);
-    return {};
-  }
+  float* out = _static_samples.data();
 
-  result = _static_svfs[voice].next(0, result);
-  result = _random_dcs[voice].next(0, result);
-  return result;
+  _static_noise.update(sr, rate_hz);
+  _static_noise.next(out, lanes);
+  for (int v = 0; v < lanes; v++)
+    out[v] = unipolar_to_bipolar(out[v]);
+
+  _static_svf.init(w, res * max_res, init_random_svf<SVFType>);
+  _static_svf.next(out, lanes);
+  _static_dc.next(out, lanes);
 }
 
 template <bool AutoFdbk> float
@@ -1050,7 +1127,6 @@ osc_engine::process_tuning_mode_unison(plugin_block& block, cv_audio_matrix_mixd
   int dsf_parts = (int)std::round(block_auto[param_dsf_parts][0].real());
   int global_pb_range = block.state.all_block_automation[module_global_in][0][global_in_param_pb_range][0].step();
   
-  int rand_seed = block_auto[param_rand_seed][0].step();
   int kps_mid_note = block_auto[param_kps_mid][0].step();
   float kps_mid_freq = block.pitch_to_freq_with_tuning<TuningMode>(kps_mid_note);
 
@@ -1123,6 +1199,7 @@ osc_engine::process_tuning_mode_unison(plugin_block& block, cv_audio_matrix_mixd
   // note this must react to oversmp
   float sync_xover_ms = block_auto[param_hard_sync_xover][0].real();
   int sync_over_samples = (int)(sync_xover_ms * 0.001 * block.sample_rate * oversmp_factor);
+  bool sync_blep = block_auto[param_hard_sync_blep][0].step() != 0;
 
   // need an osc that uses phase to do FM
   osc_osc_matrix_fm_modulator* fm_modulator = nullptr;
@@ -1173,6 +1250,22 @@ osc_engine::process_tuning_mode_unison(plugin_block& block, cv_audio_matrix_mixd
       max_pitch_sync = base_pitch_sync + detune_apply;
     }
 
+    osc_wave_input wave_in;
+    wave_in.dsf = nullptr;
+    wave_in.dsf_running = true;
+    wave_in.sqr_pw = pw_curve[mod_index];
+    wave_in.sin_mix = sin_mix_curve[mod_index];
+    wave_in.saw_mix = saw_mix_curve[mod_index];
+    wave_in.tri_mix = tri_mix_curve[mod_index];
+    wave_in.sqr_mix = sqr_mix_curve[mod_index];
+
+    // static noise runs for all unison voices at once
+    if constexpr (Static)
+    {
+      float rand_rate_hz = rand_rate_curve[mod_index] * 0.01 * oversampled_rate;
+      generate_static<StaticSVFType>(uni_voices, oversampled_rate, rand_freq_curve[mod_index], stc_res_curve[mod_index], rand_rate_hz);
+    }
+
     for (int v = 0; v < uni_voices; v++)
     {
       float synced_sample = 0;
@@ -1196,42 +1289,46 @@ osc_engine::process_tuning_mode_unison(plugin_block& block, cv_audio_matrix_mixd
 
       float pan = min_pan + (max_pan - min_pan) * v / uni_voice_range;
 
+      float phase_fm = 0;
+      (void)phase_fm;
       if constexpr (!KPS && !Static)
       {
         // FM is oversampled, so frame, not mod_index!
-        float phase_fm = (*fm_modulator_sig)[v + 1][frame];
-        _sync_phases[v] += phase_fm / oversmp_factor;
-        if (_sync_phases[v] < 0 || _sync_phases[v] >= 1) _sync_phases[v] -= std::floor(_sync_phases[v]);
-        if (_sync_phases[v] == 1) _sync_phases[v] = 0; // this could be more efficient?
-        assert(0 <= _sync_phases[v] && _sync_phases[v] < 1);
+        phase_fm = (*fm_modulator_sig)[v + 1][frame] / oversmp_factor;
+        apply_phase_fm(_sync_phases[v], phase_fm);
+      }
+
+      if constexpr (DSF)
+      {
+        wave_in.dsf = &_dsf_generators[v];
+        wave_in.dsf->init(oversampled_rate, freq_sync, dsf_parts, dsf_dist, dsf_dcy_curve[mod_index]);
       }
 
-      if constexpr (Saw) synced_sample += generate_saw(_sync_phases[v], inc_sync) * saw_mix_curve[mod_index];
-      if constexpr (Sin) synced_sample += std::sin(2.0f * pi32 * _sync_phases[v]) * sin_mix_curve[mod_index];
-      if constexpr (Tri) synced_sample += generate_triangle(_sync_phases[v], inc_sync) * tri_mix_curve[mod_index];
-      if constexpr (Sqr) synced_sample += generate_sqr(_sync_phases[v], inc_sync, pw_curve[mod_index]) * sqr_mix_curve[mod_index];
-      if constexpr (DSF) synced_sample = generate_dsf<int>(_sync_phases[v], oversampled_rate, freq_sync, dsf_parts, dsf_dist, dsf_dcy_curve[mod_index]);
+      if constexpr (!Sync && (Sin || Saw || Tri || Sqr || DSF))
+        synced_sample = generate_wave<Sin, Saw, Tri, Sqr, DSF>(_sync_phases[v], inc_sync, wave_in);
 
       // generate the unsynced sample and crossover
-      float unsynced_sample = 0;
-      (void)unsynced_sample;
       if constexpr (Sync)
       {
-        if (_unsync_samples[v] > 0)
+        if (_sync_blep_due[v])
+        {
+          osc_wave_input direct_in = wave_in;
+          direct_in.dsf_running = false;
+          synced_sample = generate_wave<Sin, Saw, Tri, Sqr, DSF>(_sync_phases[v], 0.0f, direct_in);
+          synced_sample += _sync_bleps[v];
+          _sync_blep_due[v] = false;
+          _sync_bleps[v] = 0;
+        }
+        else if (_unsync_samples[v] == 0)
+          synced_sample = generate_wave<Sin, Saw, Tri, Sqr, DSF>(_sync_phases[v], inc_sync, wave_in);
+        else
         {
           // FM is oversampled, so frame, not mod_index!
-          float phase_fm = (*fm_modulator_sig)[v + 1][frame];
-          _unsync_phases[v] += phase_fm / oversmp_factor;
-          if (_unsync_phases[v] < 0 || _unsync_phases[v] >= 1) _unsync_phases[v] -= std::floor(_unsync_phases[v]);
-          if (_unsync_phases[v] == 1) _unsync_phases[v] = 0; // this could be more efficient?
-          assert(0 <= _unsync_phases[v] && _unsync_phases[v] < 1);
-
-          if constexpr (Saw) unsynced_sample += generate_saw(_unsync_phases[v], inc_sync) * saw_mix_curve[mod_index];
-          if constexpr (Sin) unsynced_sample += std::sin(2.0f * pi32 * _unsync_phases[v]) * sin_mix_curve[mod_index];
-          if constexpr (Tri) unsynced_sample += generate_triangle(_unsync_phases[v], inc_sync) * tri_mix_curve[mod_index];
-          if constexpr (Sqr) unsynced_sample += generate_sqr(_unsync_phases[v], inc_sync, pw_curve[mod_index]) * sqr_mix_curve[mod_index];
-          if constexpr (DSF) unsynced_sample = generate_dsf<int>(_unsync_phases[v], oversampled_rate, freq_sync, dsf_parts, dsf_dist, dsf_dcy_curve[mod_index]);
-
+          apply_phase_fm(_unsync_phases[v], phase_fm);
+          osc_wave_input direct_in = wave_in;
+          direct_in.dsf_running = false;
+          synced_sample = generate_wave<Sin, Saw, Tri, Sqr, DSF>(_sync_phases[v], inc_sync, direct_in);
+          float unsynced_sample = generate_wave<Sin, Saw, Tri, Sqr, DSF>(_unsync_phases[v], inc_sync, direct_in);
           increment_and_wrap_phase(_unsync_phases[v], inc_sync);
           float unsynced_weight = _unsync_samples[v]-- / (sync_over_samples + 1.0f);
           synced_sample = unsynced_weight * unsynced_sample + (1.0f - unsynced_weight) * synced_sample;
@@ -1240,11 +1337,7 @@ osc_engine::process_tuning_mode_unison(plugin_block& block, cv_audio_matrix_mixd
 
       if constexpr (KPS) synced_sample = generate_kps<KPSAutoFdbk>(v, oversampled_rate, freq_sync, kps_fdbk_curve[mod_index], kps_stretch_curve[mod_index], kps_mid_freq);
 
-      if constexpr (Static)
-      {
-        float rand_rate_hz = rand_rate_curve[mod_index] * 0.01 * oversampled_rate;
-        synced_sample = generate_static<StaticSVFType>(v, oversampled_rate, rand_freq_curve[mod_index], stc_res_curve[mod_index], rand_seed, rand_rate_hz);
-      }
+      if constexpr (Static) synced_sample = _static_samples[v];
 
       increment_and_wrap_phase(_sync_phases[v], inc_sync);
 
@@ -1253,8 +1346,26 @@ osc_engine::process_tuning_mode_unison(plugin_block& block, cv_audio_matrix_mixd
       {
         if(increment_and_wrap_phase(_ref_phases[v], inc_ref))
         {
-          _unsync_phases[v] = _sync_phases[v];
-          _unsync_samples[v] = sync_over_samples;
+          // blep mode: no crossover, smooth out the step over this sample and the next
+          // reset_pos is the time since the reset happened, as a fraction of a sample
+          if (sync_blep)
+          {
+            float reset_pos = std::clamp(_ref_phases[v] / inc_ref, 0.0f, 1.0f);
+            float reset_phase = _sync_phases[v] - reset_pos * inc_sync;
+            reset_phase -= std::floor(reset_phase);
+            osc_wave_input direct_in = wave_in;
+            direct_in.dsf_running = false;
+            float step = generate_wave<Sin, Saw, Tri, Sqr, DSF>(0.0f, 0.0f, direct_in);
+            step -= generate_wave<Sin, Saw, Tri, Sqr, DSF>(reset_phase, 0.0f, direct_in);
+            synced_sample += step * 0.5f * reset_pos * reset_pos;
+            _sync_bleps[v] = -step * 0.5f * (1.0f - reset_pos) * (1.0f - reset_pos);
+            _sync_blep_due[v] = true;
+          }
+          else
+          {
+            _unsync_phases[v] = _sync_phases[v];
+            _unsync_samples[v] = sync_over_samples;
+          }
           _sync_phases[v] = _ref_phases[v] * inc_sync / inc_ref;
         }
       }
@@ -1267,24 +1378,12 @@ osc_engine::process_tuning_mode_unison(plugin_block& block, cv_audio_matrix_mixd
   // note AM is *NOT* oversampled like FM
   // now we have all the individual unison voice outputs, start modulating
   // apply AM/RM afterwards (since we can self-modulate, so modulator takes *our* own_audio into account)
-  auto& am_modulator = get_osc_osc_matrix_am_modulator(block);
-  auto const& am_modulated = am_modulator.modulate_am(block, block.module_slot, modulation);
-  for(int v = 0; v < uni_voices; v++)
-    for (int c = 0; c < 2; c++)
-      for (int f = block.start_frame; f < block.end_frame; f++)
-        block.state.own_audio[0][v + 1][c][f] = am_modulated[v + 1][c][f];
-  
+  // AM, unison total and attenuation are done in a single pass over own_audio.
   // This means we can exceed [-1, 1] but just dividing
   // by gen_count * uni_voices gets quiet real quick.
   float attn = std::sqrt(generator_count * uni_voices);
-  for (int c = 0; c < 2; c++)
-    for (int f = block.start_frame; f < block.end_frame; f++)
-    {
-      float uni_total = 0;
-      for (int v = 0; v < uni_voices; v++)
-        uni_total += block.state.own_audio[0][v + 1][c][f];
-      block.state.own_audio[0][0][c][f] = uni_total / attn;
-    }
+  auto& am_modulator = get_osc_osc_matrix_am_modulator(block);
+  am_modulator.modulate_am(block, block.module_slot, modulation, block.state.own_audio[0], attn);
 }
 
 }
\ No newline at end of file
@@ -1,24 +1,33 @@
 #pragma once
 
 #include <cmath>
+#include <cassert>
 
 // https://cytomic.com/files/dsp/SvfLinearTrapOptimised2.pdf
 namespace firefly_synth
 {
 
-// targeted to stereo use
-class state_var_filter
+// lambert continued fraction truncated at depth 7
+// measured relative error < 1.5e-9 up to 0.99 * pi / 2
+// good enough for the bilinear prewarp and much cheaper than std::tan
+inline double
+svf_tan(double w)
 {
-  double _k;
-  double _ic1eq[2];
-  double _ic2eq[2];
-  double _a1, _a2, _a3;
-  double _m0, _m1, _m2;
-  void init(double w, double res, double g, double a);
+  double w2 = w * w;
+  double num = w * (2027025 - w2 * (270270 - w2 * (6930 - 36 * w2)));
+  double den = 2027025 - w2 * (945945 - w2 * (51975 - w2 * (630 - w2)));
+  return num / den;
+}
+
+// coefficients only, so they can be shared between filter states
+struct state_var_filter_coeffs
+{
+  double k;
+  double a1, a2, a3;
+  double m0, m1, m2;
 
-public:
   void clear();
-  double next(int ch, double in);
+  void init(double w, double res, double g, double a);
 
   void init_lpf(double w, double res);
   void init_hpf(double w, double res);
@@ -31,104 +40,231 @@ public:
   void init_hsh(double w, double res, double db_gain);
 };
 
-inline void 
-state_var_filter::clear()
+// multiple filters sharing the same coefficients, e.g. stereo channels or osc unison voices
+// state and coefficients default to double, float state drifts up to -50db from double
+// at low cutoff and high resonance when oversampled, only the audio in/out is float
+// float sample type is opt-in for wide lanes where the drift doesn't matter (noise),
+// it packs twice the lanes per register, for 2 lanes double is just as fast
+// lanes are kept in separate arrays so next() runs all lanes at once and 
+// vectorizes across them, output mix is done in the same pass
+// next() can be limited to the first count lanes, e.g. active unison voices
+// coefficients can be set directly (init), only when cutoff or resonance changes (init with
+// change detection) or ramped towards a target (init_ramp) for control rate interpolation
+template <int Lanes, class Sample = double>
+class state_var_filter_lanes
 {
-  _ic1eq[0] = 0;
-  _ic1eq[1] = 0;
-  _ic2eq[0] = 0;
-  _ic2eq[1] = 0;
+  struct lane_coeffs { Sample a1, a2, a3, m0, m1, m2; };
+
+  double _w = -1;
+  double _res = -1;
+  Sample _ic1eq[Lanes];
+  Sample _ic2eq[Lanes];
+  lane_coeffs _c = {};
+  lane_coeffs _delta = {};
+  lane_coeffs _target = {};
+  int _ramp_samples = 0;
+  bool _has_coeffs = false;
 
-  _k = 0;
-  _a1 = _a2 = _a3 = 0;
-  _m0 = _m1 = _m2 = 0;
+  static lane_coeffs to_lane(state_var_filter_coeffs const& c);
+
+public:
+  void clear();
+  void next_ramp();
+  void next(float* inout, int count = Lanes);
+
+  void init(state_var_filter_coeffs const& c);
+  void init_ramp(state_var_filter_coeffs const& target, int samples);
+
+  // Init is void(state_var_filter_coeffs&, double w, double res)
+  template <class Init>
+  void init(double w, double res, Init init_coeffs);
+};
+
+// targeted to stereo use, left and right in one go
+typedef state_var_filter_lanes<2> state_var_filter;
+
+inline void
+state_var_filter_coeffs::clear()
+{
+  k = 0;
+  a1 = a2 = a3 = 0;
+  m0 = m1 = m2 = 0;
 }
 
 inline void
-state_var_filter::init(double w, double res, double g, double a)
+state_var_filter_coeffs::init(double w, double res, double g, double a)
 {
-  _k = (2 - 2 * res) / a;
-  _a1 = 1 / (1 + g * (g + _k));
-  _a2 = g * _a1;
-  _a3 = g * _a2;
+  k = (2 - 2 * res) / a;
+  a1 = 1 / (1 + g * (g + k));
+  a2 = g * a1;
+  a3 = g * a2;
 }
 
 inline void
-state_var_filter::init_lpf(double w, double res)
+state_var_filter_coeffs::init_lpf(double w, double res)
 {
-  init(w, res, std::tan(w), 1);
-  _m0 = 0; _m1 = 0; _m2 = 1;
+  init(w, res, svf_tan(w), 1);
+  m0 = 0; m1 = 0; m2 = 1;
 }
 
 inline void
-state_var_filter::init_hpf(double w, double res)
+state_var_filter_coeffs::init_hpf(double w, double res)
 {
-  init(w, res, std::tan(w), 1);
-  _m0 = 1; _m1 = -_k; _m2 = -1;
+  init(w, res, svf_tan(w), 1);
+  m0 = 1; m1 = -k; m2 = -1;
 }
 
 inline void
-state_var_filter::init_bpf(double w, double res)
+state_var_filter_coeffs::init_bpf(double w, double res)
 {
-  init(w, res, std::tan(w), 1);
-  _m0 = 0; _m1 = 1; _m2 = 0;
+  init(w, res, svf_tan(w), 1);
+  m0 = 0; m1 = 1; m2 = 0;
 }
 
 inline void
-state_var_filter::init_bsf(double w, double res)
+state_var_filter_coeffs::init_bsf(double w, double res)
 {
-  init(w, res, std::tan(w), 1);
-  _m0 = 1; _m1 = -_k; _m2 = 0;
+  init(w, res, svf_tan(w), 1);
+  m0 = 1; m1 = -k; m2 = 0;
 }
 
 inline void
-state_var_filter::init_apf(double w, double res)
+state_var_filter_coeffs::init_apf(double w, double res)
 {
-  init(w, res, std::tan(w), 1);
-  _m0 = 1; _m1 = -2 * _k; _m2 = 0;
+  init(w, res, svf_tan(w), 1);
+  m0 = 1; m1 = -2 * k; m2 = 0;
 }
 
 inline void
-state_var_filter::init_peq(double w, double res)
+state_var_filter_coeffs::init_peq(double w, double res)
 {
-  init(w, res, std::tan(w), 1);
-  _m0 = 1; _m1 = -_k; _m2 = -2;
+  init(w, res, svf_tan(w), 1);
+  m0 = 1; m1 = -k; m2 = -2;
 }
 
 inline void
-state_var_filter::init_bll(double w, double res, double db_gain)
+state_var_filter_coeffs::init_bll(double w, double res, double db_gain)
 {
   double a = std::pow(10.0, db_gain / 40.0);
-  init(w, res, std::tan(w), a);
-  _m0 = 1; _m1 = _k * (a * a - 1); _m2 = 0;
+  init(w, res, svf_tan(w), a);
+  m0 = 1; m1 = k * (a * a - 1); m2 = 0;
 }
 
 inline void
-state_var_filter::init_lsh(double w, double res, double db_gain)
+state_var_filter_coeffs::init_lsh(double w, double res, double db_gain)
 {
   double a = std::pow(10.0, db_gain / 40.0);
-  init(w, res, std::tan(w) / std::sqrt(a), 1);
-  _m0 = 1; _m1 = _k * (a - 1); _m2 = a * a - 1;
+  init(w, res, svf_tan(w) / std::sqrt(a), 1);
+  m0 = 1; m1 = k * (a - 1); m2 = a * a - 1;
 }
 
 inline void
-state_var_filter::init_hsh(double w, double res, double db_gain)
+state_var_filter_coeffs::init_hsh(double w, double res, double db_gain)
 {
   double a = std::pow(10.0, db_gain / 40.0);
-  init(w, res, std::tan(w) * std::sqrt(a), 1);
-  _m0 = a * a; _m1 = _k * (1 - a) * a; _m2 = 1 - a * a;
+  init(w, res, svf_tan(w) * std::sqrt(a), 1);
+  m0 = a * a; m1 = k * (1 - a) * a; m2 = 1 - a * a;
 }
 
-inline double
-state_var_filter::next(int ch, double in)
+template <int Lanes, class Sample> inline typename state_var_filter_lanes<Lanes, Sample>::lane_coeffs
+state_var_filter_lanes<Lanes, Sample>::to_lane(state_var_filter_coeffs const& c)
 {
-  double v0 = in;
-  double v3 = v0 - _ic2eq[ch];
-  double v1 = _a1 * _ic1eq[ch] + _a2 * v3;
-  double v2 = _ic2eq[ch] + _a2 * _ic1eq[ch] + _a3 * v3;
-  _ic1eq[ch] = 2 * v1 - _ic1eq[ch];
-  _ic2eq[ch] = 2 * v2 - _ic2eq[ch];
-  return _m0 * v0 + _m1 * v1 + _m2 * v2;
+  lane_coeffs result;
+  result.a1 = (Sample)c.a1; result.a2 = (Sample)c.a2; result.a3 = (Sample)c.a3;
+  result.m0 = (Sample)c.m0; result.m1 = (Sample)c.m1; result.m2 = (Sample)c.m2;
+  return result;
 }
 
-}
\ No newline at end of file
+template <int Lanes, class Sample> inline void
+state_var_filter_lanes<Lanes, Sample>::clear()
+{
+  _w = -1;
+  _res = -1;
+  _c = {};
+  _ramp_samples = 0;
+  _has_coeffs = false;
+  for (int l = 0; l < Lanes; l++)
+    _ic1eq[l] = _ic2eq[l] = 0;
+}
+
+template <int Lanes, class Sample> inline void
+state_var_filter_lanes<Lanes, Sample>::init(state_var_filter_coeffs const& c)
+{
+  _w = -1;
+  _res = -1;
+  _c = to_lane(c);
+  _ramp_samples = 0;
+  _has_coeffs = true;
+}
+
+template <int Lanes, class Sample> template <class Init> inline void
+state_var_filter_lanes<Lanes, Sample>::init(double w, double res, Init init_coeffs)
+{
+  if (w == _w && res == _res) return;
+  state_var_filter_coeffs c = {};
+  init_coeffs(c, w, res);
+  init(c);
+  _w = w;
+  _res = res;
+}
+
+// first call after clear() jumps straight to target
+// the ramp starts on the current sample: the first next() already takes
+// one step, the last of the samples next() calls runs at the target
+template <int Lanes, class Sample> inline void
+state_var_filter_lanes<Lanes, Sample>::init_ramp(state_var_filter_coeffs const& target, int samples)
+{
+  if (!_has_coeffs || samples <= 1)
+  {
+    init(target);
+    return;
+  }
+  _w = -1;
+  _res = -1;
+  _target = to_lane(target);
+  _ramp_samples = samples;
+  _delta.a1 = (_target.a1 - _c.a1) / samples;
+  _delta.a2 = (_target.a2 - _c.a2) / samples;
+  _delta.a3 = (_target.a3 - _c.a3) / samples;
+  _delta.m0 = (_target.m0 - _c.m0) / samples;
+  _delta.m1 = (_target.m1 - _c.m1) / samples;
+  _delta.m2 = (_target.m2 - _c.m2) / samples;
+  next_ramp();
+}
+
+// call once per frame after next()
+template <int Lanes, class Sample> inline void
+state_var_filter_lanes<Lanes, Sample>::next_ramp()
+{
+  if (_ramp_samples == 0) return;
+  if (--_ramp_samples == 0)
+  {
+    _c = _target;
+    return;
+  }
+  _c.a1 += _delta.a1;
+  _c.a2 += _delta.a2;
+  _c.a3 += _delta.a3;
+  _c.m0 += _delta.m0;
+  _c.m1 += _delta.m1;
+  _c.m2 += _delta.m2;
+}
+
+template <int Lanes, class Sample> inline void
+state_var_filter_lanes<Lanes, Sample>::next(float* inout, int count)
+{
+  assert(0 < count && count <= Lanes);
+  lane_coeffs const c = _c;
+  for (int l = 0; l < count; l++)
+  {
+    Sample v0 = inout[l];
+    Sample v3 = v0 - _ic2eq[l];
+    Sample v1 = c.a1 * _ic1eq[l] + c.a2 * v3;
+    Sample v2 = _ic2eq[l] + c.a2 * _ic1eq[l] + c.a3 * v3;
+    _ic1eq[l] = 2 * v1 - _ic1eq[l];
+    _ic2eq[l] = 2 * v2 - _ic2eq[l];
+    inout[l] = (float)(c.m0 * v0 + c.m1 * v1 + c.m2 * v2);
+  }
+}
+
+}
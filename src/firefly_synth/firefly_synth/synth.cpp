@@ -255,13 +255,32 @@ make_audio_routing_menu_handler(plugin_state* state, bool global)
   return std::make_unique<audio_routing_menu_handler>(state, cv_params, std::vector({ audio_params }));
 }
 
+cv_matrix_mixdown::
+cv_matrix_mixdown(plugin_topo const& topo)
+{
+  // same layout as plugin_desc.param_mappings.topo_to_modulatable
+  int count = 0;
+  for (int m = 0; m < topo.modules.size(); m++)
+    for (int mi = 0; mi < topo.modules[m].info.slot_count; mi++)
+      for (int p = 0; p < topo.modules[m].params.size(); p++)
+        if (topo.modules[m].params[p].dsp.can_modulate(mi))
+          count += topo.modules[m].params[p].info.slot_count;
+  _curves.resize(count);
+}
+
+void
+cv_matrix_mixdown::bind(plugin_desc const& desc)
+{
+  assert(_curves.size() == desc.modulatable_count);
+  _topo_to_index = &desc.param_mappings.topo_to_modulatable;
+}
+
 cv_audio_matrix_mixdown
 make_static_cv_matrix_mixdown(plugin_block& block)
 {
-  cv_audio_matrix_mixdown result;
   auto const& topo = *block.plugin_desc_.plugin;
-  plugin_dims dims(topo, topo.audio_polyphony);
-  result.resize(dims.module_slot_param_slot);
+  cv_audio_matrix_mixdown result(topo);
+  result.bind(block.plugin_desc_);
   for (int m = 0; m < topo.modules.size(); m++)
   {
     auto const& module = topo.modules[m];
@@ -271,7 +290,7 @@ make_static_cv_matrix_mixdown(plugin_block& block)
         auto const& param = module.params[p];
         if (param.dsp.can_modulate(mi))
           for (int pi = 0; pi < param.info.slot_count; pi++)
-            result[m][mi][p][pi] = &block.state.all_accurate_automation[m][mi][p][pi];
+            result.curve(m, mi, p, pi) = &block.state.all_accurate_automation[m][mi][p][pi];
       }
   }
   return result;
@@ -520,8 +539,8 @@ synth_topo(format_basic_config const* config, bool is_fx, std::string const& ful
   result->modules[module_voice_mix] = voice_mix_topo(module_section_hidden, is_fx);
   result->modules[module_external_audio] = external_audio_topo(module_section_hidden, is_fx);
   result->modules[module_env] = env_topo(is_fx? module_section_hidden: module_section_env, { 0, 0 });
-  result->modules[module_gfx] = fx_topo(module_section_gfx, { 0, 0 }, true, is_fx);
-  result->modules[module_vfx] = fx_topo(is_fx ? module_section_hidden : module_section_vfx, { 0, 0 }, false, is_fx);
+  result->modules[module_gfx] = fx_topo(module_section_gfx, { 0, 0 }, true, is_fx, result.get());
+  result->modules[module_vfx] = fx_topo(is_fx ? module_section_hidden : module_section_vfx, { 0, 0 }, false, is_fx, result.get());
   result->modules[module_glfo] = lfo_topo(module_section_glfo, { 0, 0 }, true, is_fx);
   result->modules[module_vlfo] = lfo_topo(is_fx ? module_section_hidden : module_section_vlfo, { 0, 0 }, false, is_fx);
   result->modules[module_osc] = osc_topo(is_fx ? module_section_hidden : module_section_osc, { 0, 0 });
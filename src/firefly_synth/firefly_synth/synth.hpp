@@ -68,12 +68,51 @@ struct oscillator_context
 };
 
 // everybody needs these
-typedef plugin_base::jarray<plugin_base::jarray<
-  float, 1> const*, 4> cv_matrix_mixdown;
-typedef plugin_base::jarray<plugin_base::jarray<
-  float, 1> const*, 4> cv_audio_matrix_mixdown;
-typedef plugin_base::jarray<plugin_base::jarray<
-  float, 1> const*, 2> cv_cv_matrix_mixdown;
+// single module slot out of the cv mixdown, indexed [param][param slot]
+class cv_cv_matrix_mixdown
+{
+  std::vector<int> const* _params = {};
+  plugin_base::jarray<float, 1> const* const* _curves = {};
+
+public:
+  cv_cv_matrix_mixdown() = default;
+  cv_cv_matrix_mixdown(std::vector<int> const* params, plugin_base::jarray<float, 1> const* const* curves):
+  _params(params), _curves(curves) {}
+
+  plugin_base::jarray<float, 1> const* const* operator[](int param) const
+  { assert((*_params)[param] != -1); return _curves + (*_params)[param]; }
+};
+
+// curve per modulatable param in the plugin, indexed [module][module slot][param][param slot] 
+// through plugin_desc, so per-voice matrix memory scales with modulatable params only
+class cv_matrix_mixdown
+{
+  std::vector<plugin_base::jarray<float, 1> const*> _curves = {};
+  std::vector<std::vector<std::vector<int>>> const* _topo_to_index = {};
+
+  struct module_mixdown
+  {
+    cv_matrix_mixdown const* mixdown;
+    int module;
+    cv_cv_matrix_mixdown operator[](int slot) const 
+    { return mixdown->module_slot(module, slot); }
+  };
+
+public:
+  cv_matrix_mixdown() = default;
+  cv_matrix_mixdown(plugin_base::plugin_topo const& topo);
+
+  // no allocation, so ok on the audio thread
+  void bind(plugin_base::plugin_desc const& desc);
+  plugin_base::jarray<float, 1> const*& curve(int module, int slot, int param, int param_slot)
+  { return _curves[(*_topo_to_index)[module][slot][param] + param_slot]; }
+
+  module_mixdown operator[](int module) const { return { this, module }; }
+  cv_cv_matrix_mixdown module_slot(int module, int slot) const
+  { return cv_cv_matrix_mixdown(&(*_topo_to_index)[module][slot], _curves.data()); }
+};
+
+typedef cv_matrix_mixdown cv_audio_matrix_mixdown;
 
 // shared by midi and cv matrix
 enum { midi_output_cp, midi_output_pb, midi_output_cc };
@@ -94,15 +133,17 @@ enum {
 
 // used by the oscillator at the end of it's process call to apply amp/ring mod
 // (e.g. osc 2 is modulated by both osc 1 and osc 2 itself)
+// modulates the unison voices in audio in-place and writes the unison total to voice 0
 class osc_osc_matrix_am_modulator
 {
   osc_osc_matrix_engine* _engine;
 public:
   PB_PREVENT_ACCIDENTAL_COPY(osc_osc_matrix_am_modulator);
   osc_osc_matrix_am_modulator(osc_osc_matrix_engine* engine) : _engine(engine) {}
-  plugin_base::jarray<float, 3> const& modulate_am(
+  void modulate_am(
     plugin_base::plugin_block& block, int slot, 
-    cv_audio_matrix_mixdown const* cv_modulation);
+    cv_audio_matrix_mixdown const* cv_modulation,
+    plugin_base::jarray<float, 3>& audio, float uni_attn);
 };
 
 // used by the oscillator during it's process call to apply fm
@@ -166,6 +207,8 @@ public:
   PB_PREVENT_ACCIDENTAL_COPY(cv_cv_matrix_mixer);
   cv_cv_matrix_mixer(cv_cv_matrix_engine* engine) : _engine(engine) {}
   cv_cv_matrix_mixdown const& mix(plugin_base::plugin_block& block, int module, int slot);
+  // frames per value that all cv matrix routes reading from module/slot allow for
+  int source_decimation(plugin_base::plugin_block const& block, int module, int slot);
 };
 
 inline cv_cv_matrix_mixer&
@@ -225,7 +268,7 @@ plugin_base::module_topo osc_topo(int section, plugin_base::gui_position const&
 plugin_base::module_topo arpeggiator_topo(plugin_base::plugin_topo const* topo, int section, plugin_base::gui_position const& pos);
 plugin_base::module_topo voice_in_topo(int section, plugin_base::gui_position const& pos);
 plugin_base::module_topo global_in_topo(int section, bool is_fx, plugin_base::gui_position const& pos);
-plugin_base::module_topo fx_topo(int section, plugin_base::gui_position const& pos, bool global, bool is_fx);
+plugin_base::module_topo fx_topo(int section, plugin_base::gui_position const& pos, bool global, bool is_fx, plugin_base::plugin_topo const* plugin);
 plugin_base::module_topo lfo_topo(int section, plugin_base::gui_position const& pos, bool global, bool is_fx);
 plugin_base::module_topo monitor_topo(int section, plugin_base::gui_position const& pos, int polyphony, bool is_fx);
 plugin_base::module_topo audio_out_topo(int section, plugin_base::gui_position const& pos, bool global);
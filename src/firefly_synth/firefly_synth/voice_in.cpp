@@ -483,27 +483,29 @@ voice_in_engine::process_voice_mode_tuning_mode_unison(plugin_block& block)
   auto& pitch_curve = block.state.own_scratch[scratch_pitch];
   block.normalized_to_raw_block<domain_type::linear>(module_voice_in, param_pitch, pitch_curve_norm, pitch_curve);
   
+  mono_note_cursor mono_notes(block.state.mono_note_stream);
   for (int f = block.start_frame; f < block.end_frame; f++)
   {
     if constexpr (VoiceMode != engine_voice_mode_poly)
     {
-      if (block.state.mono_note_stream[f].event_type == mono_note_stream_event::off && VoiceMode == engine_voice_mode_release)
+      mono_note_state const* mono_note = mono_notes.at(f);
+      if (mono_note && mono_note->event_type == mono_note_stream_event::off && VoiceMode == engine_voice_mode_release)
         _mono_section_finished_in_voice = true;
-      if (!_mono_section_finished_in_voice && block.state.mono_note_stream[f].event_type == mono_note_stream_event::on)
+      if (!_mono_section_finished_in_voice && mono_note && mono_note->event_type == mono_note_stream_event::on)
       {
         if (porta_mode == porta_off)
         {
           // pitch switch, will be picked up by the oscs
           _position = 0;
           _porta_samples = 0;
-          _to_midi_note = block.state.mono_note_stream[f].midi_key;
+          _to_midi_note = mono_note->midi_key;
           _from_midi_note = _to_midi_note;
         }
         else
         {
           // start a new porta section within the current voice
           _from_midi_note = calc_current_porta_midi_note();
-          _to_midi_note = block.state.mono_note_stream[f].midi_key;
+          _to_midi_note = mono_note->midi_key;
           if (_first_note_in_mono_section)
           {
             _from_midi_note = _to_midi_note;
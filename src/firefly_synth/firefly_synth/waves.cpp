@@ -7,6 +7,38 @@ using namespace plugin_base;
 namespace firefly_synth
 {
 
+bool
+wave_shape_has_bi_lut(int shape)
+{
+  return wave_shape_type_sin <= shape && shape <= wave_shape_type_cos_cos_cos;
+}
+
+// function statics so each table is built once, on first use
+wave_shape_bi_lut const& 
+wave_shape_bi_lut_for(int shape)
+{
+  switch (shape)
+  {
+  case wave_shape_type_sin: { static wave_shape_bi_lut const lut(wave_shape_bi_sin); return lut; }
+  case wave_shape_type_cos: { static wave_shape_bi_lut const lut(wave_shape_bi_cos); return lut; }
+  case wave_shape_type_sin_sin: { static wave_shape_bi_lut const lut(wave_shape_bi_sin_sin); return lut; }
+  case wave_shape_type_sin_cos: { static wave_shape_bi_lut const lut(wave_shape_bi_sin_cos); return lut; }
+  case wave_shape_type_cos_sin: { static wave_shape_bi_lut const lut(wave_shape_bi_cos_sin); return lut; }
+  case wave_shape_type_cos_cos: { static wave_shape_bi_lut const lut(wave_shape_bi_cos_cos); return lut; }
+  case wave_shape_type_sin_sin_sin: { static wave_shape_bi_lut const lut(wave_shape_bi_sin_sin_sin); return lut; }
+  case wave_shape_type_sin_sin_cos: { static wave_shape_bi_lut const lut(wave_shape_bi_sin_sin_cos); return lut; }
+  case wave_shape_type_sin_cos_sin: { static wave_shape_bi_lut const lut(wave_shape_bi_sin_cos_sin); return lut; }
+  case wave_shape_type_sin_cos_cos: { static wave_shape_bi_lut const lut(wave_shape_bi_sin_cos_cos); return lut; }
+  case wave_shape_type_cos_sin_sin: { static wave_shape_bi_lut const lut(wave_shape_bi_cos_sin_sin); return lut; }
+  case wave_shape_type_cos_sin_cos: { static wave_shape_bi_lut const lut(wave_shape_bi_cos_sin_cos); return lut; }
+  case wave_shape_type_cos_cos_sin: { static wave_shape_bi_lut const lut(wave_shape_bi_cos_cos_sin); return lut; }
+  case wave_shape_type_cos_cos_cos: { static wave_shape_bi_lut const lut(wave_shape_bi_cos_cos_cos); return lut; }
+  default: break;
+  }
+  assert(false);
+  return wave_shape_bi_lut_for(wave_shape_type_sin);
+}
+
 static std::string
 wave_make_name_skew(int skew)
 {
@@ -5,6 +5,7 @@
 #include <plugin_base/helpers/multi_menu.hpp>
 
 #include <cmath>
+#include <array>
 #include <cassert>
 
 namespace firefly_synth
@@ -110,6 +111,49 @@ wave_shape_bi_fold(float in, float dsf_parts, float dsf_dcy)
   return 0.0f;
 }
 
+// table driven version of the trig shapers for the distortion, all of them
+// are periodic in the input with period 2 so any input folds into a single table
+// cubic hermite interpolated, error is around -100 dB for all shapes
+class wave_shape_bi_lut
+{
+  static int constexpr size = 1024;
+  static int constexpr mask = size - 1;
+  // 1 guard point before, 2 after
+  std::array<float, size + 3> _table = {};
+
+public:
+  template <class Shape>
+  explicit wave_shape_bi_lut(Shape shape);
+  float operator()(float in) const;
+};
+
+// built on first use per shape and shared by everything after that
+// only valid for the sin/cos family, saw, tri and fold are cheap enough as-is
+bool wave_shape_has_bi_lut(int shape);
+wave_shape_bi_lut const& wave_shape_bi_lut_for(int shape);
+
+template <class Shape>
+inline wave_shape_bi_lut::
+wave_shape_bi_lut(Shape shape)
+{
+  for (int i = 0; i < size + 3; i++)
+    _table[i] = shape(-1.0f + 2.0f * (i - 1) / size, 0.0f, 0.0f);
+}
+
+inline float
+wave_shape_bi_lut::operator()(float in) const
+{
+  // beyond this the float phase is meaningless anyway
+  float pos = (std::clamp(in, -1048576.0f, 1048576.0f) + 1.0f) * (size / 2);
+  float whole = std::floor(pos);
+  float t = pos - whole;
+  float const* p = _table.data() + ((int)whole & mask);
+  float c1 = 0.5f * (p[2] - p[0]);
+  float c2 = p[0] - 2.5f * p[1] + 2.0f * p[2] - 0.5f * p[3];
+  float c3 = 0.5f * (p[3] - p[0]) + 1.5f * (p[1] - p[2]);
+  return ((c3 * t + c2) * t + c1) * t + p[1];
+}
+
 template <class Shape, class SkewIn, class SkewOut>
 inline float wave_calc_uni(float in, float x, float y, Shape shape, SkewIn skew_in, SkewOut skew_out)
 {
@@ -123,9 +167,61 @@ inline float wave_calc_uni(float in, float x, float y, Shape shape, SkewIn skew_
 // anti-aliased dsf generator for oscis and dsf distortion
 // for osci we use PartialCount = int (float sounds ugly)
 // for distortion PartialCount = float (works as a distortion effect)
-template <class PartialCount> inline float
-generate_dsf(float phase, float sr, float freq, PartialCount parts, float dist, float decay)
+// init() is cheap when nothing changed, w^(n+1) is only recalculated on decay/partials change
+// next() is for a running phase: while the phase advances by the same increment, the sines
+// come from complex rotations instead of std::sin/cos, re-seeded from the exact phase every
+// renorm_samples to keep float drift in check, anything else (fm, sync, pitch changes) 
+// evaluates directly and re-arms the recurrence. eval() always evaluates directly
+template <class PartialCount>
+class dsf_generator
 {
+  static int constexpr renorm_samples = 64;
+
+  // params
+  float _sr = -1.0f;
+  float _freq = -1.0f;
+  float _dist = -1.0f;
+  float _decay = -1.0f;
+  PartialCount _parts = {};
+
+  // derived
+  float _n = -1.0f;
+  float _w = -1.0f;
+  float _w_pow_np1 = 0.0f;
+  float _scale = 1.0f;
+
+  // expected next phase, 0 steps means recurrence is not armed
+  int _steps = 0;
+  float _inc = -1.0f;
+  float _phase = -1.0f;
+
+  // e^iu, e^iv, e^i(u+nv) and their per-sample rotations
+  float _a_re = 0.0f, _a_im = 0.0f, _ra_re = 0.0f, _ra_im = 0.0f;
+  float _b_re = 0.0f, _b_im = 0.0f, _rb_re = 0.0f, _rb_im = 0.0f;
+  float _c_re = 0.0f, _c_im = 0.0f, _rc_re = 0.0f, _rc_im = 0.0f;
+
+  float output(float sin_u_nv, float sin_u_np1v, float sin_v_u, float sin_u, float cos_v) const;
+
+public:
+  void reset();
+  float eval(float phase) const;
+  float next(float phase, float inc);
+  void init(float sr, float freq, PartialCount parts, float dist, float decay);
+};
+
+template <class PartialCount> inline void
+dsf_generator<PartialCount>::reset()
+{
+  _steps = 0;
+  _inc = -1.0f;
+  _phase = -1.0f;
+}
+
+template <class PartialCount> inline void
+dsf_generator<PartialCount>::init(float sr, float freq, PartialCount parts, float dist, float decay)
+{
+  if (sr == _sr && freq == _freq && parts == _parts && dist == _dist && decay == _decay) return;
+
   // -1: Fundamental is implicit. 
   PartialCount ps = parts - static_cast<PartialCount>(1);
   float const decay_range = 0.99f;
@@ -136,14 +232,31 @@ generate_dsf(float phase, float sr, float freq, PartialCount parts, float dist,
 
   float n = ps;
   float w = decay * decay_range;
-  float w_pow_np1 = std::pow(w, n + 1);
-  float u = 2.0f * pi32 * phase;
-  float v = 2.0f * pi32 * dist_freq * phase / freq;
-  float a = w * std::sin(u + n * v) - std::sin(u + (n + 1) * v);
-  float x = (w * std::sin(v - u) + std::sin(u)) + w_pow_np1 * a;
-  float y = 1 + w * w - 2 * w * std::cos(v);
-  float scale = (1.0f - w_pow_np1) / (1.0f - w);
-  float result = x * scale_factor / (y * scale);
+  if (n != _n || w != _w)
+  {
+    _w_pow_np1 = std::pow(w, n + 1);
+    _scale = scale_factor * (1.0f - w) / (1.0f - _w_pow_np1);
+  }
+
+  // phasors depend on both
+  if (n != _n || dist != _dist) reset();
+
+  _n = n;
+  _w = w;
+  _sr = sr;
+  _freq = freq;
+  _dist = dist;
+  _parts = parts;
+  _decay = decay;
+}
+
+template <class PartialCount> inline float
+dsf_generator<PartialCount>::output(float sin_u_nv, float sin_u_np1v, float sin_v_u, float sin_u, float cos_v) const
+{
+  float a = _w * sin_u_nv - sin_u_np1v;
+  float x = (_w * sin_v_u + sin_u) + _w_pow_np1 * a;
+  float y = 1 + _w * _w - 2 * _w * cos_v;
+  float result = x * _scale / y;
 
   // cannot change the scale factor b/c breaking change
   // oscis are allowed to go out bounds 
@@ -152,4 +265,69 @@ generate_dsf(float phase, float sr, float freq, PartialCount parts, float dist,
   return result;
 }
 
+template <class PartialCount> inline float
+dsf_generator<PartialCount>::eval(float phase) const
+{
+  float u = 2.0f * pi32 * phase;
+  float v = 2.0f * pi32 * _dist * phase;
+  return output(std::sin(u + _n * v), std::sin(u + (_n + 1) * v), std::sin(v - u), std::sin(u), std::cos(v));
+}
+
+template <class PartialCount> inline float
+dsf_generator<PartialCount>::next(float phase, float inc)
+{
+  // same ops as increment_and_wrap_phase so a free running phase matches exactly
+  bool steady = phase == _phase && inc == _inc;
+  _phase = phase + inc;
+  float wraps = std::floor(_phase);
+  _phase -= wraps;
+
+  // increment changed or phase jumped, direct and arm next time
+  if (!steady)
+  {
+    _steps = 0;
+    _inc = inc;
+    return eval(phase);
+  }
+
+  // rotations only change with the increment
+  if (_steps == 0)
+  {
+    float du = 2.0f * pi32 * inc;
+    float dv = 2.0f * pi32 * _dist * inc;
+    _ra_re = std::cos(du); _ra_im = std::sin(du);
+    _rb_re = std::cos(dv); _rb_im = std::sin(dv);
+    _rc_re = std::cos(du + _n * dv); _rc_im = std::sin(du + _n * dv);
+  }
+
+  if (_steps == 0 || _steps == renorm_samples)
+  {
+    float u = 2.0f * pi32 * phase;
+    float v = 2.0f * pi32 * _dist * phase;
+    _a_re = std::cos(u); _a_im = std::sin(u);
+    _b_re = std::cos(v); _b_im = std::sin(v);
+    _c_re = std::cos(u + _n * v); _c_im = std::sin(u + _n * v);
+    _steps = 0;
+  }
+  _steps++;
+
+  // sin(u + (n + 1)v) = im(c * b), sin(v - u) = im(b * conj(a))
+  float result = output(_c_im, _c_re * _b_im + _c_im * _b_re, _b_im * _a_re - _b_re * _a_im, _a_im, _b_re);
+
+  float a_re = _a_re * _ra_re - _a_im * _ra_im;
+  float b_re = _b_re * _rb_re - _b_im * _rb_im;
+  float c_re = _c_re * _rc_re - _c_im * _rc_im;
+  _a_im = _a_re * _ra_im + _a_im * _ra_re;
+  _b_im = _b_re * _rb_im + _b_im * _rb_re;
+  _c_im = _c_re * _rc_im + _c_im * _rc_re;
+  _a_re = a_re;
+  _b_re = b_re;
+  _c_re = c_re;
+
+  // v = 2pi * dist * phase jumps at the phase wrap unless dist is whole
+  // so the phasors can't rotate past it, reseed from the wrapped phase
+  if (wraps != 0.0f) _steps = renorm_samples;
+  return result;
+}
+
 }
\ No newline at end of file